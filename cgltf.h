@@ -25,47 +25,194 @@
  * `cgltf_options` is the struct passed to `cgltf_parse()` to control
  * parts of the parsing process. You can use it to force the file type
  * and provide memory allocation callbacks. Should be zero-initialized
- * to trigger default behavior.
+ * to trigger default behavior. After a successful parse,
+ * `cgltf_data::json_token_count` holds the number of JSON tokens that were
+ * needed; passing it as `json_token_count` for later loads of the same
+ * asset allocates the token buffer up front.
+ *
+ * If `cgltf_options::in_place_strings` is set, strings parsed from the JSON
+ * (names, URIs, MIME types, attribute names and the asset and extension
+ * strings) are not copied. Instead, the quote that ends each of them in the
+ * JSON is overwritten with a terminating zero and the string points into the
+ * JSON data, which saves one allocation per string. `cgltf_parse()` then casts
+ * away the const of its `data` argument, which must stay writable and alive
+ * until `cgltf_free()`; `cgltf_parse_file()` uses its own copy of the file.
  *
  * `cgltf_data` is the struct allocated and filled by `cgltf_parse()`.
  * It generally mirrors the glTF format as described by the spec (see
  * https://github.com/KhronosGroup/glTF/tree/master/specification/2.0).
  *
  * `void cgltf_free(cgltf_data*)` frees the allocated `cgltf_data`
- * variable.
+ * variable. If `cgltf_options::arena` was set when parsing, all strings and
+ * arrays of the parsed data share a few large memory blocks, so freeing them
+ * doesn't need to walk the data.
  *
  * `cgltf_result cgltf_load_buffers(const cgltf_options*, cgltf_data*,
  * const char* gltf_path)` can be optionally called to open and read buffer
  * files using the `FILE*` APIs. The `gltf_path` argument is the path to
  * the original glTF file, which allows the parser to resolve the path to
- * buffer files.
+ * buffer files. Buffers whose `data` is already set are left untouched, so
+ * you can provide your own memory for any buffer beforehand. Each buffer's
+ * `data_free_method` tells `cgltf_free()` whether and how to release its
+ * `data`; it is `cgltf_data_free_method_none` for memory you provide and
+ * for the GLB binary chunk, which buffers reference without copying.
+ * If `cgltf_options::densify_sparse` is set, every sparse accessor is also
+ * expanded once into `cgltf_accessor::sparse_data`, which holds all of its
+ * elements tightly packed in the accessor's component type, so that reading
+ * it no longer needs to look up the sparse indices.
+ *
+ * `cgltf_result cgltf_load_buffers_async(const cgltf_options*, cgltf_data*,
+ * const char* gltf_path, cgltf_buffer_loader** out_loader)` decodes data URIs
+ * like `cgltf_load_buffers()`, then issues the reads of all buffer files at
+ * once through `cgltf_options::file_read_async` and returns without waiting
+ * for them. Each call receives the full path, the number of bytes to read and
+ * a request index; when the read finishes, pass its result to
+ * `cgltf_buffer_loader_complete(loader, request, result, data, size)`. The
+ * data must come from `cgltf_options::memory_alloc`, or be releasable with
+ * `cgltf_options::file_release` if that is set. `cgltf_buffer_loader_pending()`
+ * returns the number of reads that have not completed yet; once it reaches 0,
+ * `cgltf_buffer_loader_finish()` frees the loader, densifies sparse accessors
+ * if requested and returns the first error of any read. Reads may complete on
+ * any thread if `CGLTF_PTHREADS` is defined, otherwise on the thread that
+ * polls. Without `file_read_async`, the files are read before
+ * `cgltf_load_buffers_async()` returns. Either way, the error reported is the
+ * one of the first buffer that failed to load, not of the first read that
+ * completed. Reading the files one after the other stops at the first
+ * failure and leaves the remaining buffers unloaded.
+ *
+ * If `cgltf_options::parallel_buffers` is set, `cgltf_load_buffers()` reads
+ * the buffer files as independent tasks through `cgltf_options::run_tasks`,
+ * or on `cgltf_options::thread_count` threads like `cgltf_validate_parallel()`.
+ * `memory_alloc`, `memory_free` and `file_read` are then called from several
+ * threads at once and must be thread-safe.
+ *
+ * `cgltf_options::file_read` replaces the `FILE*` APIs and memory mappings
+ * used by `cgltf_parse_file()` and `cgltf_load_buffers()`, e.g. to read from
+ * an archive or a virtual file system. It receives the number of bytes to
+ * read in `*size`, or 0 to read the whole file, and sets `*size` to the
+ * number of bytes it returns in `*data`. `cgltf_free()` releases the data
+ * with `cgltf_options::file_release`, or `memory_free` if that is NULL.
+ * With `cgltf_options::in_place_strings`, the data returned for the glTF file
+ * itself must be writable.
+ *
+ * `cgltf_result cgltf_load_buffers_lazy(const cgltf_options*, cgltf_data*,
+ * const char* gltf_path)` resolves the GLB binary chunk and data URIs like
+ * `cgltf_load_buffers()`, but reads nothing from buffer files yet. Instead,
+ * `const void* cgltf_buffer_view_data(cgltf_buffer_view*)` reads the bytes
+ * of a buffer view the first time it is needed into
+ * `cgltf_buffer_view::data`, seeking to its range of the file instead of
+ * reading the whole buffer. With `cgltf_options::memory_map` or
+ * `cgltf_options::file_read`, the first access maps or reads its whole
+ * buffer instead. `cgltf_result cgltf_prefetch_meshes(cgltf_mesh* const*
+ * meshes, cgltf_size meshes_count)` loads all buffer views used by the
+ * primitives and morph targets of the given meshes at once and reports the
+ * first error. These two functions modify the data, so they must not run on
+ * several threads at once. The accessor functions take const accessors and
+ * never load anything, so they stay safe to call from several threads; they
+ * fail for buffer views that have not been loaded yet, such as those of
+ * animations, which need `cgltf_buffer_view_data()` first.
+ * `cgltf_buffer_view_data()` returns NULL if the data is not available, and
+ * `cgltf_validate()` skips the checks of indices in buffer views whose data
+ * has not been loaded. With `cgltf_options::densify_sparse`, the views of
+ * sparse accessors are loaded right away and expanded like in
+ * `cgltf_load_buffers()`.
+ *
+ * If `cgltf_options::decode_images` is set, `cgltf_load_buffers()` also
+ * decodes images with base64 data URIs into `cgltf_image::data` and
+ * `cgltf_image::data_size`, which `cgltf_free()` releases. Images stored in
+ * files or buffer views are left to the caller.
  *
  * `cgltf_result cgltf_load_buffer_base64(const cgltf_options* options,
  * cgltf_size size, const char* base64, void** out_data)` decodes
- * base64-encoded data content. Used internally by `cgltf_load_buffers()`
- * and may be useful if you're not dealing with normal files.
+ * base64-encoded data content, 16 to 64 characters at a time with SSSE3,
+ * AVX2 or NEON. On x86 with GCC, Clang or MSVC, the SSSE3 and AVX2 kernels
+ * are compiled even if the compiler does not target them and are used when
+ * the CPU supports them. Used internally by
+ * `cgltf_load_buffers()` and may be useful if you're not dealing with
+ * normal files.
  *
  * `cgltf_result cgltf_parse_file(const cgltf_options* options, const
  * char* path, cgltf_data** out_data)` can be used to open the given
  * file using `FILE*` APIs and parse the data using `cgltf_parse()`.
  *
+ * If `cgltf_options::memory_map` is set, `cgltf_parse_file()` and
+ * `cgltf_load_buffers()` map files into memory on POSIX systems instead of
+ * reading them into freshly allocated buffers. `file_data` and the data of
+ * buffers loaded from files then point into read-only mappings, which
+ * `cgltf_free()` unmaps. Other platforms fall back to `FILE*` APIs.
+ *
  * `cgltf_result cgltf_validate(cgltf_data*)` can be used to do additional
  * checks to make sure the parsed glTF data is valid.
  *
+ * `cgltf_result cgltf_validate_parallel(const cgltf_options*, cgltf_data*)` runs
+ * the same checks split into chunks of accessors, buffer views, meshes and nodes
+ * that are handed to `cgltf_options::run_tasks`, which may run them on any
+ * threads and must return once all of them have finished. Without a callback,
+ * the chunks run on `cgltf_options::thread_count` POSIX threads if
+ * `CGLTF_PTHREADS` is defined before including the implementation, and serially
+ * otherwise. The result is always the one `cgltf_validate()` would return.
+ *
  * `cgltf_node_transform_local` converts the translation / rotation / scale properties of a node
  * into a mat4.
  *
  * `cgltf_node_transform_world` calls `cgltf_node_transform_local` on every ancestor in order
  * to compute the root-to-node transformation.
  *
+ * `cgltf_scene_transforms_world` computes the root-to-node transformation of every node in a scene
+ * in a single top-down pass, reusing the parent's result for its children instead of walking the
+ * ancestors of each node. The matrices are written to `out_matrices` in depth-first pre-order:
+ * every root in `scene->nodes` is followed by the subtrees of its children, in order. Returns the
+ * number of matrices written, or the number of matrices needed if `out_matrices` is NULL.
+ *
  * `cgltf_accessor_read_float` reads a certain element from an accessor and converts it to
  * floating point, assuming that `cgltf_load_buffers` has already been called. The passed-in element
  * size is the number of floats in the output buffer, which should be in the range [1, 16]. Returns
- * false if the passed-in element_size is too small, or if the accessor is sparse.
+ * false if the passed-in element_size is too small, or if the accessor has neither a buffer view nor
+ * sparse data. Elements of sparse accessors are looked up with a binary search over the sparse indices
+ * unless the accessor has been densified by `cgltf_load_buffers`.
  *
  * `cgltf_accessor_read_index` is similar to its floating-point counterpart, but it returns size_t
  * and only works with single-component data types.
  *
+ * `cgltf_accessor_unpack_floats` converts all elements of an accessor into a tightly packed
+ * floating point array, producing the same values as `cgltf_accessor_read_float`. `float_count`
+ * is the number of floats available in `out`. Returns the number of floats written, or the number
+ * of floats needed to unpack the whole accessor if `out` is NULL. Sparse accessors are unpacked
+ * from their base data first, after which the sparse values are applied in a single pass.
+ * `cgltf_accessor_unpack_floats_range` does the same for the `count` elements starting at
+ * element `first`.
+ *
+ * `cgltf_accessor_unpack_indices` copies the first `index_count` elements of a scalar accessor with
+ * an unsigned integer component type into `out`, an array of `uint8_t`, `uint16_t` or `uint32_t` as
+ * given by `out_component_size`, widening smaller indices as needed. Returns the number of indices
+ * written, or the number of elements in the accessor if `out` is NULL. Returns 0 if the accessor
+ * doesn't hold indices or if they don't fit into `out_component_size` bytes.
+ *
+ * `cgltf_animation_channel_sample` evaluates an animation channel at the given time and writes the
+ * result to `out`: 3 floats for translations and scales, 4 for rotations (spherically interpolated
+ * and normalized) and one per morph target for weights. Cubic spline samplers are evaluated as Hermite
+ * curves, and times outside of the keyframes hold the first or last value. Returns the number of floats
+ * written, 0 if `float_count` is too small, or the number of floats needed if `out` is NULL. `cursor`
+ * may be NULL; otherwise it should start at 0 and is updated with the keyframe that was used, so that
+ * playback moving forward in time finds the next keyframe without a binary search.
+ * `cgltf_animation_sample` does the same for every channel of an animation, writing the results one
+ * channel after the other to `out_pose`, with one cursor per channel in `cursors` (or NULL).
+ *
+ * `cgltf_bake_animation` resamples every channel of an animation with `cgltf_animation_channel_sample`
+ * at `frame_rate` frames per second, from time 0 to the last keyframe, into one block allocated with
+ * `cgltf_options::memory_alloc`. The frames of each channel are stored contiguously in
+ * `cgltf_baked_channel::values`; with `quantize_rotations`, rotations are stored as normalized 16-bit
+ * integers in `cgltf_baked_channel::quantized_values` instead. `cgltf_baked_animation_sample` writes the
+ * same pose layout as `cgltf_animation_sample`, computing the frame index from the time and interpolating
+ * linearly between two frames, without any keyframe search or accessor decoding. STEP channels hold the
+ * previous frame. Sampling only reads the baked animation, so it can outlive the `cgltf_data` it was baked
+ * from. Free the result with `cgltf_free_baked_animation`.
+ *
+ * `cgltf_find_node_by_name`, `cgltf_find_mesh_by_name`, `cgltf_find_material_by_name` and
+ * `cgltf_find_animation_by_name` return the first object with the given name, or NULL if there is
+ * none. If `cgltf_options::name_index` was set when parsing, they look the name up in hash tables
+ * that are built once after parsing; otherwise they scan the objects.
+ *
  * `cgltf_result cgltf_copy_extras_json(const cgltf_data*, const cgltf_extras*,
  * char* dest, cgltf_size* dest_size)` allows to retrieve the "extras" data that
  * can be attached to many glTF objects (which can be arbitrary JSON data). The
@@ -96,15 +243,6 @@ typedef enum cgltf_file_type
 	cgltf_file_type_glb,
 } cgltf_file_type;
 
-typedef struct cgltf_options
-{
-	cgltf_file_type type; /* invalid == auto detect */
-	cgltf_size json_token_count; /* 0 == auto */
-	void* (*memory_alloc)(void* user, cgltf_size size);
-	void (*memory_free) (void* user, void* ptr);
-	void* memory_user_data;
-} cgltf_options;
-
 typedef enum cgltf_result
 {
 	cgltf_result_success,
@@ -118,6 +256,39 @@ typedef enum cgltf_result
 	cgltf_result_out_of_memory,
 } cgltf_result;
 
+typedef struct cgltf_buffer_loader cgltf_buffer_loader;
+
+typedef struct cgltf_options
+{
+	cgltf_file_type type; /* invalid == auto detect */
+	cgltf_size json_token_count; /* 0 == auto, grows the token buffer as needed */
+	void* (*memory_alloc)(void* user, cgltf_size size);
+	void (*memory_free) (void* user, void* ptr);
+	void* memory_user_data;
+	cgltf_bool arena; /* allocate parsed data from a few large blocks that cgltf_free releases at once */
+	cgltf_bool memory_map; /* map files read by cgltf_parse_file and cgltf_load_buffers instead of copying them (POSIX only) */
+	cgltf_bool densify_sparse; /* cgltf_load_buffers expands sparse accessors into cgltf_accessor::sparse_data */
+	cgltf_bool in_place_strings; /* names, URIs and MIME types point into the JSON data, which is modified, instead of being copied */
+	cgltf_bool name_index; /* build hash tables for the cgltf_find_*_by_name functions while parsing */
+	void (*run_tasks)(void* user, cgltf_size task_count, void (*task)(void* task_data, cgltf_size task_index), void* task_data); /* NULL == use thread_count */
+	void* tasks_user_data;
+	cgltf_size thread_count; /* threads used without run_tasks when CGLTF_PTHREADS is defined, 0 or 1 == serial */
+	cgltf_bool parallel_buffers; /* cgltf_load_buffers reads buffer files as tasks on run_tasks or thread_count threads */
+	cgltf_bool decode_images; /* cgltf_load_buffers decodes base64 data: URIs of images into cgltf_image::data */
+	cgltf_result (*file_read)(void* user, const char* path, cgltf_size* size, void** data); /* NULL == FILE* APIs or memory_map */
+	void (*file_release)(void* user, void* data); /* releases data returned by file_read or file_read_async, NULL == memory_free */
+	void (*file_read_async)(void* user, const char* path, cgltf_size size, cgltf_buffer_loader* loader, cgltf_size request); /* NULL == cgltf_load_buffers_async reads synchronously */
+	void* file_user_data;
+} cgltf_options;
+
+typedef enum cgltf_data_free_method
+{
+	cgltf_data_free_method_none, /* data is owned by the caller and is not freed */
+	cgltf_data_free_method_memory_free, /* data is freed with cgltf_options::memory_free */
+	cgltf_data_free_method_munmap, /* data is a read-only file mapping that is unmapped */
+	cgltf_data_free_method_file_release, /* data is released with cgltf_options::file_release */
+} cgltf_data_free_method;
+
 typedef enum cgltf_buffer_view_type
 {
 	cgltf_buffer_view_type_invalid,
@@ -215,6 +386,8 @@ typedef struct cgltf_buffer
 	cgltf_size size;
 	char* uri;
 	void* data; /* loaded by cgltf_load_buffers */
+	cgltf_data_free_method data_free_method; /* how cgltf_free releases data */
+	void* lazy_file; /* set by cgltf_load_buffers_lazy if data is read on demand */
 	cgltf_extras extras;
 } cgltf_buffer;
 
@@ -225,6 +398,7 @@ typedef struct cgltf_buffer_view
 	cgltf_size size;
 	cgltf_size stride; /* 0 == automatically determined by accessor */
 	cgltf_buffer_view_type type;
+	void* data; /* read on demand by cgltf_buffer_view_data for lazily loaded buffers */
 	cgltf_extras extras;
 } cgltf_buffer_view;
 
@@ -256,6 +430,7 @@ typedef struct cgltf_accessor
 	cgltf_float max[16];
 	cgltf_bool is_sparse;
 	cgltf_accessor_sparse sparse;
+	void* sparse_data; /* tightly packed elements with the sparse values applied, see cgltf_options::densify_sparse */
 	cgltf_extras extras;
 } cgltf_accessor;
 
@@ -273,6 +448,8 @@ typedef struct cgltf_image
 	char* uri;
 	cgltf_buffer_view* buffer_view;
 	char* mime_type;
+	void* data; /* decoded from a base64 data: URI by cgltf_load_buffers if cgltf_options::decode_images is set */
+	cgltf_size data_size;
 	cgltf_extras extras;
 } cgltf_image;
 
@@ -475,6 +652,25 @@ typedef struct cgltf_animation {
 	cgltf_extras extras;
 } cgltf_animation;
 
+typedef struct cgltf_baked_channel {
+	const cgltf_animation_channel* channel; /* source channel, only valid while its cgltf_data is */
+	cgltf_animation_path_type target_path;
+	cgltf_size components;
+	cgltf_bool step;
+	cgltf_bool rotation; /* values are quaternions, normalized after interpolation */
+	cgltf_float* values; /* frame_count * components floats, frame after frame */
+	short* quantized_values; /* frame_count * 4 normalized quaternion components, used instead of values for quantized rotations */
+} cgltf_baked_channel;
+
+typedef struct cgltf_baked_animation {
+	cgltf_float frame_rate;
+	cgltf_size frame_count;
+	cgltf_baked_channel* channels;
+	cgltf_size channels_count;
+	void (*memory_free) (void* user, void* ptr);
+	void* memory_user_data;
+} cgltf_baked_animation;
+
 typedef struct cgltf_asset {
 	char* copyright;
 	char* generator;
@@ -487,6 +683,9 @@ typedef struct cgltf_data
 {
 	cgltf_file_type file_type;
 	void* file_data;
+	cgltf_size file_size;
+	cgltf_bool file_data_mapped;
+	cgltf_bool file_data_released; /* file_data was read by cgltf_options::file_read and is released with file_release */
 
 	cgltf_asset asset;
 
@@ -544,12 +743,20 @@ typedef struct cgltf_data
 
 	const char* json;
 	cgltf_size json_size;
+	cgltf_bool in_place_strings; /* strings point into the JSON data, see cgltf_options::in_place_strings */
+	cgltf_size json_token_count; /* number of JSON tokens used, can be passed as cgltf_options::json_token_count */
 
 	const void* bin;
 	cgltf_size bin_size;
 
+	void* (*memory_alloc)(void* user, cgltf_size size);
 	void (*memory_free) (void* user, void* ptr);
 	void* memory_user_data;
+	void (*file_release)(void* user, void* data);
+	void* file_user_data;
+	void* arena;
+	void* name_index;
+	void* lazy_files;
 } cgltf_data;
 
 cgltf_result cgltf_parse(
@@ -568,20 +775,58 @@ cgltf_result cgltf_load_buffers(
 		cgltf_data* data,
 		const char* gltf_path);
 
+cgltf_result cgltf_load_buffers_async(
+		const cgltf_options* options,
+		cgltf_data* data,
+		const char* gltf_path,
+		cgltf_buffer_loader** out_loader);
+
+void cgltf_buffer_loader_complete(cgltf_buffer_loader* loader, cgltf_size request, cgltf_result result, void* data, cgltf_size size);
+cgltf_size cgltf_buffer_loader_pending(cgltf_buffer_loader* loader);
+cgltf_result cgltf_buffer_loader_finish(cgltf_buffer_loader* loader);
+
+cgltf_result cgltf_load_buffers_lazy(
+		const cgltf_options* options,
+		cgltf_data* data,
+		const char* gltf_path);
+
+const void* cgltf_buffer_view_data(cgltf_buffer_view* view);
+cgltf_result cgltf_prefetch_meshes(cgltf_mesh* const* meshes, cgltf_size meshes_count);
 
 cgltf_result cgltf_load_buffer_base64(const cgltf_options* options, cgltf_size size, const char* base64, void** out_data);
 
 cgltf_result cgltf_validate(
 		cgltf_data* data);
 
+cgltf_result cgltf_validate_parallel(
+		const cgltf_options* options,
+		cgltf_data* data);
+
 void cgltf_free(cgltf_data* data);
 
 void cgltf_node_transform_local(const cgltf_node* node, cgltf_float* out_matrix);
 void cgltf_node_transform_world(const cgltf_node* node, cgltf_float* out_matrix);
+cgltf_size cgltf_scene_transforms_world(const cgltf_scene* scene, cgltf_float* out_matrices);
 
 cgltf_bool cgltf_accessor_read_float(const cgltf_accessor* accessor, cgltf_size index, cgltf_float* out, cgltf_size element_size);
 cgltf_size cgltf_accessor_read_index(const cgltf_accessor* accessor, cgltf_size index);
 
+cgltf_size cgltf_accessor_unpack_floats(const cgltf_accessor* accessor, cgltf_float* out, cgltf_size float_count);
+cgltf_size cgltf_accessor_unpack_floats_range(const cgltf_accessor* accessor, cgltf_size first, cgltf_size count, cgltf_float* out, cgltf_size float_count);
+cgltf_size cgltf_accessor_unpack_indices(const cgltf_accessor* accessor, void* out, cgltf_size out_component_size, cgltf_size index_count);
+
+cgltf_size cgltf_animation_channel_sample(const cgltf_animation_channel* channel, cgltf_float time, cgltf_size* cursor, cgltf_float* out, cgltf_size float_count);
+cgltf_size cgltf_animation_sample(const cgltf_animation* animation, cgltf_float time, cgltf_size* cursors, cgltf_float* out_pose, cgltf_size float_count);
+
+cgltf_result cgltf_bake_animation(const cgltf_options* options, const cgltf_animation* animation, cgltf_float frame_rate, cgltf_bool quantize_rotations, cgltf_baked_animation** out_baked);
+cgltf_size cgltf_baked_animation_sample(const cgltf_baked_animation* baked, cgltf_float time, cgltf_float* out_pose, cgltf_size float_count);
+void cgltf_free_baked_animation(cgltf_baked_animation* baked);
+
+cgltf_node* cgltf_find_node_by_name(const cgltf_data* data, const char* name);
+cgltf_mesh* cgltf_find_mesh_by_name(const cgltf_data* data, const char* name);
+cgltf_material* cgltf_find_material_by_name(const cgltf_data* data, const char* name);
+cgltf_animation* cgltf_find_animation_by_name(const cgltf_data* data, const char* name);
+
 cgltf_result cgltf_copy_extras_json(const cgltf_data* data, const cgltf_extras* extras, char* dest, cgltf_size* dest_size);
 
 #ifdef __cplusplus
@@ -609,6 +854,60 @@ cgltf_result cgltf_copy_extras_json(const cgltf_data* data, const cgltf_extras*
 #include <stdlib.h> /* For malloc, free */
 #include <stdio.h>  /* For fopen */
 #include <limits.h> /* For UINT_MAX etc */
+#include <locale.h> /* For localeconv */
+#include <math.h>   /* For sqrtf, acosf, sinf */
+
+#if !defined(CGLTF_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#define CGLTF_MMAP
+#include <sys/mman.h> /* For mmap */
+#include <sys/stat.h> /* For fstat */
+#include <fcntl.h>    /* For open */
+#include <unistd.h>   /* For close */
+#endif
+
+#ifdef CGLTF_PTHREADS
+#include <pthread.h> /* For pthread_create */
+#endif
+
+/* SIMD kernels are selected at compile time, except for base64 decoding below; define CGLTF_NO_SIMD to use the scalar code only */
+#if !defined(CGLTF_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CGLTF_SSE2
+#include <emmintrin.h> /* For SSE2 intrinsics */
+#endif
+
+#if !defined(CGLTF_NO_SIMD) && (defined(__SSSE3__) || defined(__AVX2__))
+#define CGLTF_SSSE3
+#include <tmmintrin.h> /* For SSSE3 intrinsics */
+#endif
+
+#if !defined(CGLTF_NO_SIMD) && defined(__AVX2__)
+#define CGLTF_AVX2
+#include <immintrin.h> /* For AVX2 intrinsics */
+#endif
+
+/* x86 builds that don't target AVX2 still compile the SSSE3 and AVX2 base64 kernels and check the CPU before using them */
+#if !defined(CGLTF_NO_SIMD) && !defined(CGLTF_AVX2) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && \
+	(defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define CGLTF_CPU_DISPATCH
+#include <immintrin.h> /* For SSSE3 and AVX2 intrinsics */
+#ifdef _MSC_VER
+#include <intrin.h> /* For __cpuid */
+#endif
+#endif
+
+#if defined(CGLTF_CPU_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+#define CGLTF_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define CGLTF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CGLTF_TARGET_SSSE3
+#define CGLTF_TARGET_AVX2
+#endif
+
+/* Only AArch64 NEON has a vector divide, which is needed to match the scalar results exactly */
+#if !defined(CGLTF_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#define CGLTF_NEON
+#include <arm_neon.h> /* For NEON intrinsics */
+#endif
 
 /* JSMN_PARENT_LINKS is necessary to make parsing large structures linear in input size */
 #define JSMN_PARENT_LINKS
@@ -691,6 +990,59 @@ static void* cgltf_calloc(cgltf_options* options, size_t element_size, cgltf_siz
 	return result;
 }
 
+typedef struct cgltf_arena_block
+{
+	struct cgltf_arena_block* next;
+	cgltf_size size;
+	cgltf_size used;
+} cgltf_arena_block;
+
+typedef struct cgltf_arena
+{
+	cgltf_arena_block* blocks;
+	cgltf_size block_size;
+	void* (*memory_alloc)(void* user, cgltf_size size);
+	void* memory_user_data;
+} cgltf_arena;
+
+static void* cgltf_arena_alloc(void* user, cgltf_size size)
+{
+	cgltf_arena* arena = (cgltf_arena*)user;
+
+	// Keep every allocation aligned for the largest member type used in cgltf_data
+	size = (size + 7) & ~(cgltf_size)7;
+
+	cgltf_arena_block* block = arena->blocks;
+
+	if (!block || block->size - block->used < size)
+	{
+		cgltf_size block_size = arena->block_size > size ? arena->block_size : size;
+
+		block = (cgltf_arena_block*)arena->memory_alloc(arena->memory_user_data, sizeof(cgltf_arena_block) + block_size);
+		if (!block)
+		{
+			return NULL;
+		}
+
+		block->next = arena->blocks;
+		block->size = block_size;
+		block->used = 0;
+
+		arena->blocks = block;
+		arena->block_size *= 2;
+	}
+
+	void* result = (char*)(block + 1) + block->used;
+	block->used += size;
+	return result;
+}
+
+static void cgltf_arena_free(void* user, void* ptr)
+{
+	(void)user;
+	(void)ptr;
+}
+
 static cgltf_result cgltf_parse_json(cgltf_options* options, const uint8_t* json_chunk, cgltf_size size, cgltf_data** out_data);
 
 cgltf_result cgltf_parse(const cgltf_options* options, const void* data, cgltf_size size, cgltf_data** out_data)
@@ -825,12 +1177,124 @@ cgltf_result cgltf_parse(const cgltf_options* options, const void* data, cgltf_s
 	return cgltf_result_success;
 }
 
-cgltf_result cgltf_parse_file(const cgltf_options* options, const char* path, cgltf_data** out_data)
+#ifdef CGLTF_MMAP
+static cgltf_result cgltf_mmap_file(const char* path, cgltf_size size, cgltf_bool writable, void** out_data, cgltf_size* out_size)
 {
-	if (options == NULL)
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
 	{
-		return cgltf_result_invalid_options;
+		return cgltf_result_file_not_found;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size < 0)
+	{
+		close(fd);
+		return cgltf_result_io_error;
+	}
+
+	cgltf_size file_size = (cgltf_size)st.st_size;
+
+	if (size == 0)
+	{
+		size = file_size;
+	}
+
+	if (file_size < size || size == 0)
+	{
+		close(fd);
+		return cgltf_result_io_error;
+	}
+
+	// Writes to a private mapping are copy-on-write, so they never reach the file
+	void* file_data = mmap(NULL, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping stays valid after the descriptor is closed
+	close(fd);
+
+	if (file_data == MAP_FAILED)
+	{
+		return cgltf_result_io_error;
+	}
+
+	*out_data = file_data;
+	*out_size = size;
+
+	return cgltf_result_success;
+}
+#endif
+
+static void cgltf_free_file_data(const cgltf_options* options, void* data, cgltf_size size, cgltf_data_free_method free_method)
+{
+	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+
+	switch (free_method)
+	{
+	case cgltf_data_free_method_memory_free:
+		memory_free(options->memory_user_data, data);
+		break;
+
+	case cgltf_data_free_method_munmap:
+#ifdef CGLTF_MMAP
+		munmap(data, size);
+#endif
+		break;
+
+	case cgltf_data_free_method_file_release:
+		options->file_release(options->file_user_data, data);
+		break;
+
+	default:
+		;
+	}
+
+	(void)size;
+}
+
+// Reads *size bytes of a file, or all of it if *size is 0, through cgltf_options::file_read,
+// a memory mapping or the FILE* APIs. *size receives the number of bytes read.
+static cgltf_result cgltf_read_file(const cgltf_options* options, const char* path, cgltf_bool writable, cgltf_size* size, void** out_data, cgltf_data_free_method* out_free_method)
+{
+	if (options->file_read)
+	{
+		cgltf_size expected_size = *size;
+		cgltf_data_free_method free_method = options->file_release ? cgltf_data_free_method_file_release : cgltf_data_free_method_memory_free;
+
+		void* file_data = NULL;
+		cgltf_result result = options->file_read(options->file_user_data, path, size, &file_data);
+
+		if (result != cgltf_result_success)
+		{
+			return result;
+		}
+
+		if (*size < expected_size)
+		{
+			cgltf_free_file_data(options, file_data, *size, free_method);
+			return cgltf_result_io_error;
+		}
+
+		*out_data = file_data;
+		*out_free_method = free_method;
+
+		return cgltf_result_success;
+	}
+
+#ifdef CGLTF_MMAP
+	if (options->memory_map)
+	{
+		cgltf_result result = cgltf_mmap_file(path, *size, writable, out_data, size);
+
+		if (result == cgltf_result_success)
+		{
+			*out_free_method = cgltf_data_free_method_munmap;
+		}
+
+		return result;
 	}
+#endif
+
+	(void)writable;
 
 	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
 	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
@@ -841,25 +1305,31 @@ cgltf_result cgltf_parse_file(const cgltf_options* options, const char* path, cg
 		return cgltf_result_file_not_found;
 	}
 
-	fseek(file, 0, SEEK_END);
+	cgltf_size file_size = *size;
 
-	long length = ftell(file);
-	if (length < 0)
+	if (file_size == 0)
 	{
-		fclose(file);
-		return cgltf_result_io_error;
-	}
+		fseek(file, 0, SEEK_END);
+
+		long length = ftell(file);
+		if (length < 0)
+		{
+			fclose(file);
+			return cgltf_result_io_error;
+		}
+
+		fseek(file, 0, SEEK_SET);
 
-	fseek(file, 0, SEEK_SET);
+		file_size = (cgltf_size)length;
+	}
 
-	char* file_data = (char*)memory_alloc(options->memory_user_data, length);
+	char* file_data = (char*)memory_alloc(options->memory_user_data, file_size);
 	if (!file_data)
 	{
 		fclose(file);
 		return cgltf_result_out_of_memory;
 	}
 
-	cgltf_size file_size = (cgltf_size)length;
 	cgltf_size read_size = fread(file_data, 1, file_size, file);
 
 	fclose(file);
@@ -870,15 +1340,49 @@ cgltf_result cgltf_parse_file(const cgltf_options* options, const char* path, cg
 		return cgltf_result_io_error;
 	}
 
-	cgltf_result result = cgltf_parse(options, file_data, file_size, out_data);
+	*size = file_size;
+	*out_data = file_data;
+	*out_free_method = cgltf_data_free_method_memory_free;
+
+	return cgltf_result_success;
+}
+
+cgltf_result cgltf_parse_file(const cgltf_options* options, const char* path, cgltf_data** out_data)
+{
+	if (options == NULL)
+	{
+		return cgltf_result_invalid_options;
+	}
+
+	void* file_data = NULL;
+	cgltf_size file_size = 0;
+	cgltf_data_free_method free_method = cgltf_data_free_method_none;
+
+	cgltf_result result = cgltf_read_file(options, path, options->in_place_strings, &file_size, &file_data, &free_method);
 
 	if (result != cgltf_result_success)
 	{
-		memory_free(options->memory_user_data, file_data);
+		return result;
+	}
+
+	result = cgltf_parse(options, file_data, file_size, out_data);
+
+	if (result != cgltf_result_success)
+	{
+		cgltf_free_file_data(options, file_data, file_size, free_method);
 		return result;
 	}
 
 	(*out_data)->file_data = file_data;
+	(*out_data)->file_size = file_size;
+	(*out_data)->file_data_mapped = free_method == cgltf_data_free_method_munmap;
+	(*out_data)->file_data_released = free_method == cgltf_data_free_method_file_release;
+
+	if (free_method == cgltf_data_free_method_file_release)
+	{
+		(*out_data)->file_release = options->file_release;
+		(*out_data)->file_user_data = options->file_user_data;
+	}
 
 	return cgltf_result_success;
 }
@@ -902,86 +1406,280 @@ static void cgltf_combine_paths(char* path, const char* base, const char* uri)
 	}
 }
 
-static cgltf_result cgltf_load_buffer_file(const cgltf_options* options, cgltf_size size, const char* uri, const char* gltf_path, void** out_data)
+/* 6-bit value of every base64 character, 255 for characters outside of the alphabet */
+static const uint8_t cgltf_base64_values[256] = {
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 62, 255, 255, 255, 63,
+	52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 255, 255, 255, 255, 255, 255,
+	255, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+	15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 255, 255, 255, 255, 255,
+	255, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+	41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
+
+#define CGLTF_CPU_SSSE3 1
+#define CGLTF_CPU_AVX2 2
+
+#ifdef CGLTF_CPU_DISPATCH
+/* Returns the CGLTF_CPU_ flags of the instruction sets that the CPU and the OS support */
+static int cgltf_cpu_features(void)
 {
-	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
-	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	int max_leaf = info[0];
+
+	__cpuid(info, 1);
+	int features = (info[2] & (1 << 9)) ? CGLTF_CPU_SSSE3 : 0;
 
-	char* path = (char*)memory_alloc(options->memory_user_data, strlen(uri) + strlen(gltf_path) + 1);
-	if (!path)
+	/* AVX2 also needs the OS to save the upper halves of the YMM registers */
+	if (max_leaf >= 7 && (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6)
 	{
-		return cgltf_result_out_of_memory;
+		__cpuidex(info, 7, 0);
+		features |= (info[1] & (1 << 5)) ? CGLTF_CPU_AVX2 : 0;
 	}
 
-	cgltf_combine_paths(path, gltf_path, uri);
+	return features;
+#else
+	return (__builtin_cpu_supports("ssse3") ? CGLTF_CPU_SSSE3 : 0) | (__builtin_cpu_supports("avx2") ? CGLTF_CPU_AVX2 : 0);
+#endif
+}
+#endif
+
+#if defined(CGLTF_SSSE3) || defined(CGLTF_CPU_DISPATCH)
+/* Maps 16 base64 characters to their 6-bit values; *valid has all bits set for characters of the alphabet */
+CGLTF_TARGET_SSSE3 static __m128i cgltf_base64_values_ssse3(__m128i chars, __m128i* valid)
+{
+	__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), chars));
+	__m128i lower = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), chars));
+	__m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chars));
+	__m128i plus = _mm_cmpeq_epi8(chars, _mm_set1_epi8('+'));
+	__m128i slash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('/'));
 
-	FILE* file = fopen(path, "rb");
+	__m128i shift = _mm_or_si128(_mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')), _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+		_mm_or_si128(_mm_and_si128(digit, _mm_set1_epi8(52 - '0')), _mm_or_si128(_mm_and_si128(plus, _mm_set1_epi8(62 - '+')), _mm_and_si128(slash, _mm_set1_epi8(63 - '/')))));
 
-	memory_free(options->memory_user_data, path);
+	*valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(plus, slash)));
 
-	if (!file)
-	{
-		return cgltf_result_file_not_found;
-	}
+	return _mm_add_epi8(chars, shift);
+}
 
-	char* file_data = (char*)memory_alloc(options->memory_user_data, size);
-	if (!file_data)
+/* Decodes blocks of 16 characters into 12 bytes, stopping before the first block with an invalid character */
+CGLTF_TARGET_SSSE3 static cgltf_size cgltf_base64_decode_ssse3(const char* base64, unsigned char* data, cgltf_size size)
+{
+	cgltf_size i = 0;
+
+	/* Each block stores 16 bytes, the last 4 of which are overwritten by the next one */
+	for (; size - i >= 16; i += 12, base64 += 16)
 	{
-		fclose(file);
-		return cgltf_result_out_of_memory;
-	}
+		__m128i valid;
+		__m128i values = cgltf_base64_values_ssse3(_mm_loadu_si128((const __m128i*)base64), &valid);
 
-	cgltf_size read_size = fread(file_data, 1, size, file);
+		if (_mm_movemask_epi8(valid) != 0xffff)
+		{
+			break;
+		}
 
-	fclose(file);
+		/* Merge pairs of 6-bit values into 12 bits, then pairs of those into the 24 bits of 3 bytes */
+		__m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+		__m128i packed = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
 
-	if (read_size != size)
-	{
-		memory_free(options->memory_user_data, file_data);
-		return cgltf_result_io_error;
+		_mm_storeu_si128((__m128i*)(data + i), packed);
 	}
 
-	*out_data = file_data;
-
-	return cgltf_result_success;
+	return i;
 }
+#endif
 
-cgltf_result cgltf_load_buffer_base64(const cgltf_options* options, cgltf_size size, const char* base64, void** out_data)
+#if defined(CGLTF_AVX2) || defined(CGLTF_CPU_DISPATCH)
+/* Decodes blocks of 32 characters into 24 bytes, stopping before the first block with an invalid character */
+CGLTF_TARGET_AVX2 static cgltf_size cgltf_base64_decode_avx2(const char* base64, unsigned char* data, cgltf_size size)
 {
-	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
-	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+	cgltf_size i = 0;
 
-	unsigned char* data = (unsigned char*)memory_alloc(options->memory_user_data, size);
-	if (!data)
+	/* Each block stores 32 bytes, the last 8 of which are overwritten by the next one */
+	for (; size - i >= 32; i += 24, base64 += 32)
 	{
-		return cgltf_result_out_of_memory;
-	}
+		__m256i chars = _mm256_loadu_si256((const __m256i*)base64);
 
-	unsigned int buffer = 0;
-	unsigned int buffer_bits = 0;
+		__m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), chars));
+		__m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), chars));
+		__m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+		__m256i plus = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('+'));
+		__m256i slash = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('/'));
 
-	for (cgltf_size i = 0; i < size; ++i)
-	{
-		while (buffer_bits < 8)
+		__m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, _mm256_or_si256(plus, slash)));
+
+		if (_mm256_movemask_epi8(valid) != -1)
 		{
-			char ch = *base64++;
+			break;
+		}
 
-			int index =
-				(unsigned)(ch - 'A') < 26 ? (ch - 'A') :
-				(unsigned)(ch - 'a') < 26 ? (ch - 'a') + 26 :
-				(unsigned)(ch - '0') < 10 ? (ch - '0') + 52 :
-				ch == '+' ? 62 :
-				ch == '/' ? 63 :
-				-1;
+		__m256i shift = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')), _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a'))),
+			_mm256_or_si256(_mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')), _mm256_or_si256(_mm256_and_si256(plus, _mm256_set1_epi8(62 - '+')), _mm256_and_si256(slash, _mm256_set1_epi8(63 - '/')))));
+		__m256i values = _mm256_add_epi8(chars, shift);
 
-			if (index < 0)
-			{
-				memory_free(options->memory_user_data, data);
-				return cgltf_result_io_error;
-			}
+		__m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+		__m256i packed = _mm256_shuffle_epi8(merged, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
 
-			buffer = (buffer << 6) | index;
-			buffer_bits += 6;
+		/* The shuffle works within 128-bit lanes, so the 12 bytes of both lanes are joined afterwards */
+		packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+		_mm256_storeu_si256((__m256i*)(data + i), packed);
+	}
+
+	return i;
+}
+#endif
+
+#ifdef CGLTF_NEON
+/* Maps 16 base64 characters to their 6-bit values; clears the bytes of *valid for characters outside of the alphabet */
+static uint8x16_t cgltf_base64_values_neon(uint8x16_t chars, uint8x16_t* valid)
+{
+	uint8x16_t upper = vcleq_u8(vsubq_u8(chars, vdupq_n_u8('A')), vdupq_n_u8(25));
+	uint8x16_t lower = vcleq_u8(vsubq_u8(chars, vdupq_n_u8('a')), vdupq_n_u8(25));
+	uint8x16_t digit = vcleq_u8(vsubq_u8(chars, vdupq_n_u8('0')), vdupq_n_u8(9));
+	uint8x16_t plus = vceqq_u8(chars, vdupq_n_u8('+'));
+	uint8x16_t slash = vceqq_u8(chars, vdupq_n_u8('/'));
+
+	uint8x16_t shift = vorrq_u8(vorrq_u8(vandq_u8(upper, vdupq_n_u8((uint8_t)-'A')), vandq_u8(lower, vdupq_n_u8((uint8_t)(26 - 'a')))),
+		vorrq_u8(vandq_u8(digit, vdupq_n_u8((uint8_t)(52 - '0'))), vorrq_u8(vandq_u8(plus, vdupq_n_u8((uint8_t)(62 - '+'))), vandq_u8(slash, vdupq_n_u8((uint8_t)(63 - '/'))))));
+
+	*valid = vandq_u8(*valid, vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, vorrq_u8(plus, slash))));
+
+	return vaddq_u8(chars, shift);
+}
+
+/* Decodes blocks of 64 characters into 48 bytes, stopping before the first block with an invalid character */
+static cgltf_size cgltf_base64_decode_neon(const char* base64, unsigned char* data, cgltf_size size)
+{
+	cgltf_size i = 0;
+
+	for (; size - i >= 48; i += 48, base64 += 64)
+	{
+		/* De-interleaving loads and stores keep every character of a group of 4 in its own register */
+		uint8x16x4_t chars = vld4q_u8((const uint8_t*)base64);
+
+		uint8x16_t valid = vdupq_n_u8(0xff);
+		uint8x16_t a = cgltf_base64_values_neon(chars.val[0], &valid);
+		uint8x16_t b = cgltf_base64_values_neon(chars.val[1], &valid);
+		uint8x16_t c = cgltf_base64_values_neon(chars.val[2], &valid);
+		uint8x16_t d = cgltf_base64_values_neon(chars.val[3], &valid);
+
+		if (vminvq_u8(valid) == 0)
+		{
+			break;
+		}
+
+		uint8x16x3_t bytes;
+		bytes.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+		bytes.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+		bytes.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+
+		vst3q_u8(data + i, bytes);
+	}
+
+	return i;
+}
+#endif
+
+cgltf_result cgltf_load_buffer_base64(const cgltf_options* options, cgltf_size size, const char* base64, void** out_data)
+{
+	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
+	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+
+	unsigned char* data = (unsigned char*)memory_alloc(options->memory_user_data, size);
+	if (!data)
+	{
+		return cgltf_result_out_of_memory;
+	}
+
+	// Every character needed for the data has to be valid, so a shorter string is an error; checking
+	// for that first also keeps the vector loads below from reading past the end of the string
+	if (memchr(base64, 0, (size * 4 + 2) / 3))
+	{
+		memory_free(options->memory_user_data, data);
+		return cgltf_result_io_error;
+	}
+
+	// The vector loops stop at blocks with invalid characters, which the scalar code then reports
+	cgltf_size i = 0;
+
+#if defined(CGLTF_CPU_DISPATCH)
+	int cpu_features = cgltf_cpu_features();
+#elif defined(CGLTF_AVX2)
+	int cpu_features = CGLTF_CPU_SSSE3 | CGLTF_CPU_AVX2;
+#elif defined(CGLTF_SSSE3)
+	int cpu_features = CGLTF_CPU_SSSE3;
+#endif
+
+#if defined(CGLTF_AVX2) || defined(CGLTF_CPU_DISPATCH)
+	if (cpu_features & CGLTF_CPU_AVX2)
+	{
+		i = cgltf_base64_decode_avx2(base64, data, size);
+		base64 += i / 3 * 4;
+	}
+#endif
+
+#if defined(CGLTF_SSSE3) || defined(CGLTF_CPU_DISPATCH)
+	if (cpu_features & CGLTF_CPU_SSSE3)
+	{
+		cgltf_size block_size = cgltf_base64_decode_ssse3(base64, data + i, size - i);
+		i += block_size;
+		base64 += block_size / 3 * 4;
+	}
+#elif defined(CGLTF_NEON)
+	cgltf_size block_size = cgltf_base64_decode_neon(base64, data + i, size - i);
+	i += block_size;
+	base64 += block_size / 3 * 4;
+#endif
+
+	for (; size - i >= 3; i += 3, base64 += 4)
+	{
+		unsigned int a = cgltf_base64_values[(unsigned char)base64[0]];
+		unsigned int b = cgltf_base64_values[(unsigned char)base64[1]];
+		unsigned int c = cgltf_base64_values[(unsigned char)base64[2]];
+		unsigned int d = cgltf_base64_values[(unsigned char)base64[3]];
+
+		if ((a | b | c | d) & 0x80)
+		{
+			memory_free(options->memory_user_data, data);
+			return cgltf_result_io_error;
+		}
+
+		unsigned int bits = (a << 18) | (b << 12) | (c << 6) | d;
+
+		data[i + 0] = (unsigned char)(bits >> 16);
+		data[i + 1] = (unsigned char)(bits >> 8);
+		data[i + 2] = (unsigned char)bits;
+	}
+
+	unsigned int buffer = 0;
+	unsigned int buffer_bits = 0;
+
+	for (; i < size; ++i)
+	{
+		while (buffer_bits < 8)
+		{
+			unsigned int index = cgltf_base64_values[(unsigned char)*base64++];
+
+			if (index & 0x80)
+			{
+				memory_free(options->memory_user_data, data);
+				return cgltf_result_io_error;
+			}
+
+			buffer = (buffer << 6) | index;
+			buffer_bits += 6;
 		}
 
 		data[i] = (unsigned char)(buffer >> (buffer_bits - 8));
@@ -993,13 +1691,72 @@ cgltf_result cgltf_load_buffer_base64(const cgltf_options* options, cgltf_size s
 	return cgltf_result_success;
 }
 
-cgltf_result cgltf_load_buffers(const cgltf_options* options, cgltf_data* data, const char* gltf_path)
+typedef struct cgltf_buffer_request
 {
-	if (options == NULL)
+	cgltf_buffer* buffer;
+	char* path;
+	cgltf_result result;
+} cgltf_buffer_request;
+
+struct cgltf_buffer_loader
+{
+	cgltf_options options;
+	cgltf_data* data;
+	cgltf_buffer_request* requests;
+	cgltf_size requests_count;
+	cgltf_size pending;
+#ifdef CGLTF_PTHREADS
+	pthread_mutex_t mutex;
+#endif
+};
+
+static void cgltf_buffer_loader_store(cgltf_buffer_loader* loader, cgltf_size request, cgltf_result result, void* data, cgltf_size size, cgltf_data_free_method free_method)
+{
+	cgltf_buffer* buffer = loader->requests[request].buffer;
+
+	if (result == cgltf_result_success && size < buffer->size)
 	{
-		return cgltf_result_invalid_options;
+		cgltf_free_file_data(&loader->options, data, size, free_method);
+		result = cgltf_result_io_error;
 	}
 
+	if (result == cgltf_result_success)
+	{
+		buffer->data = data;
+		buffer->data_free_method = free_method;
+	}
+
+	loader->requests[request].result = result;
+}
+
+static void cgltf_load_buffer_task(void* task_data, cgltf_size task_index)
+{
+	cgltf_buffer_loader* loader = (cgltf_buffer_loader*)task_data;
+	cgltf_buffer_request* request = &loader->requests[task_index];
+
+	void* file_data = NULL;
+	cgltf_size file_size = request->buffer->size;
+	cgltf_data_free_method free_method = cgltf_data_free_method_none;
+
+	cgltf_result result = cgltf_read_file(&loader->options, request->path, 0, &file_size, &file_data, &free_method);
+
+	cgltf_buffer_loader_store(loader, task_index, result, file_data, file_size, free_method);
+}
+
+static void cgltf_run_tasks(const cgltf_options* options, cgltf_size task_count, void (*task)(void* task_data, cgltf_size task_index), void* task_data);
+
+static cgltf_result cgltf_densify_sparse_accessors(const cgltf_options* options, cgltf_data* data);
+
+// Buffers that are still empty after cgltf_load_embedded_data are read from files next to the glTF file
+static cgltf_bool cgltf_buffer_in_file(const cgltf_buffer* buffer)
+{
+	return buffer->data == NULL && buffer->uri != NULL && buffer->size != 0 && strncmp(buffer->uri, "data:", 5) != 0;
+}
+
+// Points the first buffer of a GLB file at its binary chunk, decodes data URIs and counts the buffers
+// stored in files, along with the space needed for their paths
+static cgltf_result cgltf_load_embedded_data(const cgltf_options* options, cgltf_data* data, const char* gltf_path, cgltf_size* out_files_count, cgltf_size* out_paths_size)
+{
 	if (data->buffers_count && data->buffers[0].data == NULL && data->buffers[0].uri == NULL && data->bin)
 	{
 		if (data->bin_size < data->buffers[0].size)
@@ -1008,18 +1765,19 @@ cgltf_result cgltf_load_buffers(const cgltf_options* options, cgltf_data* data,
 		}
 
 		data->buffers[0].data = (void*)data->bin;
+		data->buffers[0].data_free_method = cgltf_data_free_method_none;
 	}
 
+	// Data URIs are decoded right away, files are only counted
+	cgltf_size files_count = 0;
+	cgltf_size paths_size = 0;
+
 	for (cgltf_size i = 0; i < data->buffers_count; ++i)
 	{
-		if (data->buffers[i].data)
-		{
-			continue;
-		}
-
 		const char* uri = data->buffers[i].uri;
 
-		if (uri == NULL)
+		// Empty buffers have nothing to read
+		if (data->buffers[i].data || uri == NULL || data->buffers[i].size == 0)
 		{
 			continue;
 		}
@@ -1036,6 +1794,8 @@ cgltf_result cgltf_load_buffers(const cgltf_options* options, cgltf_data* data,
 				{
 					return res;
 				}
+
+				data->buffers[i].data_free_method = cgltf_data_free_method_memory_free;
 			}
 			else
 			{
@@ -1044,12 +1804,45 @@ cgltf_result cgltf_load_buffers(const cgltf_options* options, cgltf_data* data,
 		}
 		else if (strstr(uri, "://") == NULL && gltf_path)
 		{
-			cgltf_result res = cgltf_load_buffer_file(options, data->buffers[i].size, uri, gltf_path, &data->buffers[i].data);
+			files_count++;
+			paths_size += strlen(gltf_path) + strlen(uri) + 1;
+		}
+		else
+		{
+			return cgltf_result_unknown_format;
+		}
+	}
+
+	for (cgltf_size i = 0; options->decode_images && i < data->images_count; ++i)
+	{
+		const char* uri = data->images[i].uri;
+
+		if (data->images[i].data || uri == NULL || strncmp(uri, "data:", 5) != 0)
+		{
+			continue;
+		}
+
+		const char* comma = strchr(uri, ',');
+
+		if (comma && comma - uri >= 7 && strncmp(comma - 7, ";base64", 7) == 0)
+		{
+			// Unlike buffers, images have no declared length, so it follows from the number of characters
+			cgltf_size length = strlen(comma + 1);
+
+			while (length > 0 && comma[length] == '=')
+			{
+				length--;
+			}
+
+			cgltf_size size = length * 3 / 4;
+			cgltf_result res = cgltf_load_buffer_base64(options, size, comma + 1, &data->images[i].data);
 
 			if (res != cgltf_result_success)
 			{
 				return res;
 			}
+
+			data->images[i].data_size = size;
 		}
 		else
 		{
@@ -1057,580 +1850,3113 @@ cgltf_result cgltf_load_buffers(const cgltf_options* options, cgltf_data* data,
 		}
 	}
 
+	*out_files_count = files_count;
+	*out_paths_size = paths_size;
+
 	return cgltf_result_success;
 }
 
-static cgltf_size cgltf_calc_size(cgltf_type type, cgltf_component_type component_type);
-
-static cgltf_size cgltf_calc_index_bound(cgltf_buffer_view* buffer_view, cgltf_size offset, cgltf_component_type component_type, cgltf_size count)
+cgltf_result cgltf_load_buffers_async(const cgltf_options* options, cgltf_data* data, const char* gltf_path, cgltf_buffer_loader** out_loader)
 {
-	char* data = (char*)buffer_view->buffer->data + offset + buffer_view->offset;
-	cgltf_size bound = 0;
-
-	switch (component_type)
+	if (options == NULL)
 	{
-	case cgltf_component_type_r_8u:
-		for (size_t i = 0; i < count; ++i)
-		{
-			cgltf_size v = ((unsigned char*)data)[i];
-			bound = bound > v ? bound : v;
-		}
-		break;
+		return cgltf_result_invalid_options;
+	}
 
-	case cgltf_component_type_r_16u:
-		for (size_t i = 0; i < count; ++i)
-		{
-			cgltf_size v = ((unsigned short*)data)[i];
-			bound = bound > v ? bound : v;
-		}
-		break;
+	cgltf_size requests_count = 0;
+	cgltf_size paths_size = 0;
 
-	case cgltf_component_type_r_32u:
-		for (size_t i = 0; i < count; ++i)
-		{
-			cgltf_size v = ((unsigned int*)data)[i];
-			bound = bound > v ? bound : v;
-		}
-		break;
+	cgltf_result embedded_result = cgltf_load_embedded_data(options, data, gltf_path, &requests_count, &paths_size);
 
-	default:
-		;
+	if (embedded_result != cgltf_result_success)
+	{
+		return embedded_result;
 	}
 
-	return bound;
-}
+	cgltf_options fixed_options = *options;
+	if (fixed_options.memory_alloc == NULL)
+	{
+		fixed_options.memory_alloc = &cgltf_default_alloc;
+	}
+	if (fixed_options.memory_free == NULL)
+	{
+		fixed_options.memory_free = &cgltf_default_free;
+	}
 
-cgltf_result cgltf_validate(cgltf_data* data)
-{
-	for (cgltf_size i = 0; i < data->accessors_count; ++i)
+	cgltf_buffer_loader* loader = (cgltf_buffer_loader*)fixed_options.memory_alloc(fixed_options.memory_user_data, sizeof(cgltf_buffer_loader) + requests_count * sizeof(cgltf_buffer_request) + paths_size);
+	if (!loader)
 	{
-		cgltf_accessor* accessor = &data->accessors[i];
+		return cgltf_result_out_of_memory;
+	}
 
-		cgltf_size element_size = cgltf_calc_size(accessor->type, accessor->component_type);
+	loader->options = fixed_options;
+	loader->data = data;
+	loader->requests = (cgltf_buffer_request*)(loader + 1);
+	loader->requests_count = requests_count;
+	loader->pending = requests_count;
 
-		if (accessor->buffer_view)
-		{
-			cgltf_size req_size = accessor->offset + accessor->stride * (accessor->count - 1) + element_size;
+#ifdef CGLTF_PTHREADS
+	pthread_mutex_init(&loader->mutex, NULL);
+#endif
 
-			if (accessor->buffer_view->size < req_size)
-			{
-				return cgltf_result_data_too_short;
-			}
-		}
+	char* path = (char*)(loader->requests + requests_count);
+	cgltf_size request = 0;
 
-		if (accessor->is_sparse)
+	for (cgltf_size i = 0; i < data->buffers_count; ++i)
+	{
+		if (!cgltf_buffer_in_file(&data->buffers[i]))
 		{
-			cgltf_accessor_sparse* sparse = &accessor->sparse;
-
-			cgltf_size indices_component_size = cgltf_calc_size(cgltf_type_scalar, sparse->indices_component_type);
-			cgltf_size indices_req_size = sparse->indices_byte_offset + indices_component_size * sparse->count;
-			cgltf_size values_req_size = sparse->values_byte_offset + element_size * sparse->count;
-
-			if (sparse->indices_buffer_view->size < indices_req_size ||
-				sparse->values_buffer_view->size < values_req_size)
-			{
-				return cgltf_result_data_too_short;
-			}
+			continue;
+		}
 
-			if (sparse->indices_component_type != cgltf_component_type_r_8u &&
-				sparse->indices_component_type != cgltf_component_type_r_16u &&
-				sparse->indices_component_type != cgltf_component_type_r_32u)
-			{
-				return cgltf_result_invalid_gltf;
-			}
+		cgltf_combine_paths(path, gltf_path, data->buffers[i].uri);
 
-			if (sparse->indices_buffer_view->buffer->data)
-			{
-				cgltf_size index_bound = cgltf_calc_index_bound(sparse->indices_buffer_view, sparse->indices_byte_offset, sparse->indices_component_type, sparse->count);
+		loader->requests[request].buffer = &data->buffers[i];
+		loader->requests[request].path = path;
+		loader->requests[request].result = cgltf_result_success;
+		request++;
 
-				if (index_bound >= accessor->count)
-				{
-					return cgltf_result_data_too_short;
-				}
-			}
-		}
+		path += strlen(path) + 1;
 	}
 
-	for (cgltf_size i = 0; i < data->buffer_views_count; ++i)
+	if (options->file_release)
 	{
-		cgltf_size req_size = data->buffer_views[i].offset + data->buffer_views[i].size;
+		data->file_release = options->file_release;
+		data->file_user_data = options->file_user_data;
+	}
+
+	*out_loader = loader;
 
-		if (data->buffer_views[i].buffer && data->buffer_views[i].buffer->size < req_size)
+	if (options->file_read_async)
+	{
+		for (cgltf_size i = 0; i < requests_count; ++i)
 		{
-			return cgltf_result_data_too_short;
+			options->file_read_async(options->file_user_data, loader->requests[i].path, loader->requests[i].buffer->size, loader, i);
 		}
 	}
-
-	for (cgltf_size i = 0; i < data->meshes_count; ++i)
+	else
 	{
-		if (data->meshes[i].weights)
+		// Every task writes only its own buffer and request, so they need no synchronization
+		if (options->parallel_buffers)
 		{
-			if (data->meshes[i].primitives_count && data->meshes[i].primitives[0].targets_count != data->meshes[i].weights_count)
-			{
-				return cgltf_result_invalid_gltf;
-			}
+			cgltf_run_tasks(&loader->options, requests_count, &cgltf_load_buffer_task, loader);
 		}
-
-		for (cgltf_size j = 0; j < data->meshes[i].primitives_count; ++j)
+		else
 		{
-			if (data->meshes[i].primitives[j].targets_count != data->meshes[i].primitives[0].targets_count)
-			{
-				return cgltf_result_invalid_gltf;
-			}
-
-			if (data->meshes[i].primitives[j].attributes_count)
+			// Reading in document order, the first failure is the one to report, so the remaining buffers stay unloaded
+			for (cgltf_size i = 0; i < requests_count; ++i)
 			{
-				cgltf_accessor* first = data->meshes[i].primitives[j].attributes[0].data;
-
-				for (cgltf_size k = 0; k < data->meshes[i].primitives[j].attributes_count; ++k)
-				{
-					if (data->meshes[i].primitives[j].attributes[k].data->count != first->count)
-					{
-						return cgltf_result_invalid_gltf;
-					}
-				}
-
-				for (cgltf_size k = 0; k < data->meshes[i].primitives[j].targets_count; ++k)
-				{
-					for (cgltf_size m = 0; m < data->meshes[i].primitives[j].targets[k].attributes_count; ++m)
-					{
-						if (data->meshes[i].primitives[j].targets[k].attributes[m].data->count != first->count)
-						{
-							return cgltf_result_invalid_gltf;
-						}
-					}
-				}
-
-				cgltf_accessor* indices = data->meshes[i].primitives[j].indices;
-
-				if (indices &&
-					indices->component_type != cgltf_component_type_r_8u &&
-					indices->component_type != cgltf_component_type_r_16u &&
-					indices->component_type != cgltf_component_type_r_32u)
-				{
-					return cgltf_result_invalid_gltf;
-				}
+				cgltf_load_buffer_task(loader, i);
 
-				if (indices && indices->buffer_view && indices->buffer_view->buffer->data)
+				if (loader->requests[i].result != cgltf_result_success)
 				{
-					cgltf_size index_bound = cgltf_calc_index_bound(indices->buffer_view, indices->offset, indices->component_type, indices->count);
-
-					if (index_bound >= first->count)
-					{
-						return cgltf_result_data_too_short;
-					}
+					break;
 				}
 			}
 		}
-	}
 
-	for (cgltf_size i = 0; i < data->nodes_count; ++i)
-	{
-		if (data->nodes[i].weights && data->nodes[i].mesh)
-		{
-			if (data->nodes[i].mesh->primitives_count && data->nodes[i].mesh->primitives[0].targets_count != data->nodes[i].weights_count)
-			{
-				return cgltf_result_invalid_gltf;
-			}
-		}
+		loader->pending = 0;
 	}
 
 	return cgltf_result_success;
 }
 
-cgltf_result cgltf_copy_extras_json(const cgltf_data* data, const cgltf_extras* extras, char* dest, cgltf_size* dest_size)
+void cgltf_buffer_loader_complete(cgltf_buffer_loader* loader, cgltf_size request, cgltf_result result, void* data, cgltf_size size)
 {
-	cgltf_size json_size = extras->end_offset - extras->start_offset;
+	cgltf_data_free_method free_method = loader->options.file_release ? cgltf_data_free_method_file_release : cgltf_data_free_method_memory_free;
 
-	if (!dest)
-	{
-		if (dest_size)
-		{
-			*dest_size = json_size + 1;
-			return cgltf_result_success;
-		}
-		return cgltf_result_invalid_options;
-	}
+	cgltf_buffer_loader_store(loader, request, result, data, size, free_method);
+
+#ifdef CGLTF_PTHREADS
+	pthread_mutex_lock(&loader->mutex);
+#endif
+
+	--loader->pending;
+
+#ifdef CGLTF_PTHREADS
+	pthread_mutex_unlock(&loader->mutex);
+#endif
+}
+
+cgltf_size cgltf_buffer_loader_pending(cgltf_buffer_loader* loader)
+{
+#ifdef CGLTF_PTHREADS
+	pthread_mutex_lock(&loader->mutex);
+	cgltf_size pending = loader->pending;
+	pthread_mutex_unlock(&loader->mutex);
+	return pending;
+#else
+	return loader->pending;
+#endif
+}
+
+cgltf_result cgltf_buffer_loader_finish(cgltf_buffer_loader* loader)
+{
+	cgltf_options options = loader->options;
+	cgltf_data* data = loader->data;
+
+	// Report the error of the first failed buffer, regardless of the order in which the reads completed
+	cgltf_result result = cgltf_result_success;
+
+	for (cgltf_size i = 0; i < loader->requests_count && result == cgltf_result_success; ++i)
+	{
+		result = loader->requests[i].result;
+	}
+
+#ifdef CGLTF_PTHREADS
+	pthread_mutex_destroy(&loader->mutex);
+#endif
+
+	options.memory_free(options.memory_user_data, loader);
+
+	if (result != cgltf_result_success)
+	{
+		return result;
+	}
+
+	return cgltf_densify_sparse_accessors(&options, data);
+}
+
+cgltf_result cgltf_load_buffers(const cgltf_options* options, cgltf_data* data, const char* gltf_path)
+{
+	if (options == NULL)
+	{
+		return cgltf_result_invalid_options;
+	}
+
+	cgltf_options sync_options = *options;
+	sync_options.file_read_async = NULL;
+
+	cgltf_buffer_loader* loader = NULL;
+	cgltf_result result = cgltf_load_buffers_async(&sync_options, data, gltf_path, &loader);
+
+	if (result != cgltf_result_success)
+	{
+		return result;
+	}
+
+	return cgltf_buffer_loader_finish(loader);
+}
+
+typedef struct cgltf_lazy_file
+{
+	const cgltf_options* options;
+	const char* path;
+} cgltf_lazy_file;
+
+cgltf_result cgltf_load_buffers_lazy(const cgltf_options* options, cgltf_data* data, const char* gltf_path)
+{
+	if (options == NULL)
+	{
+		return cgltf_result_invalid_options;
+	}
+
+	if (data->lazy_files)
+	{
+		return cgltf_result_success;
+	}
+
+	cgltf_size files_count = 0;
+	cgltf_size paths_size = 0;
+
+	cgltf_result embedded_result = cgltf_load_embedded_data(options, data, gltf_path, &files_count, &paths_size);
+
+	if (embedded_result != cgltf_result_success)
+	{
+		return embedded_result;
+	}
+
+	if (files_count == 0)
+	{
+		return cgltf_densify_sparse_accessors(options, data);
+	}
+
+	cgltf_options fixed_options = *options;
+	if (fixed_options.memory_alloc == NULL)
+	{
+		fixed_options.memory_alloc = &cgltf_default_alloc;
+	}
+	if (fixed_options.memory_free == NULL)
+	{
+		fixed_options.memory_free = &cgltf_default_free;
+	}
+
+	// The options are kept for the reads on demand, followed by the file of every buffer and its path
+	cgltf_options* lazy_options = (cgltf_options*)fixed_options.memory_alloc(fixed_options.memory_user_data, sizeof(cgltf_options) + files_count * sizeof(cgltf_lazy_file) + paths_size);
+	if (!lazy_options)
+	{
+		return cgltf_result_out_of_memory;
+	}
+
+	*lazy_options = fixed_options;
+
+	cgltf_lazy_file* files = (cgltf_lazy_file*)(lazy_options + 1);
+	char* path = (char*)(files + files_count);
+
+	for (cgltf_size i = 0; i < data->buffers_count; ++i)
+	{
+		if (!cgltf_buffer_in_file(&data->buffers[i]))
+		{
+			continue;
+		}
+
+		cgltf_combine_paths(path, gltf_path, data->buffers[i].uri);
+
+		files->options = lazy_options;
+		files->path = path;
+		data->buffers[i].lazy_file = files;
+
+		files++;
+		path += strlen(path) + 1;
+	}
+
+	if (options->file_release)
+	{
+		data->file_release = options->file_release;
+		data->file_user_data = options->file_user_data;
+	}
+
+	data->lazy_files = lazy_options;
+
+	return cgltf_densify_sparse_accessors(lazy_options, data);
+}
+
+static cgltf_result cgltf_read_file_range(const char* path, cgltf_size offset, cgltf_size size, void* out_data)
+{
+#ifdef CGLTF_MMAP
+	// Unlike fseek, lseek takes an off_t, so offsets beyond 2 GB work wherever files that large do
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		return cgltf_result_file_not_found;
+	}
+
+	if (lseek(fd, (off_t)offset, SEEK_SET) != (off_t)offset)
+	{
+		close(fd);
+		return cgltf_result_io_error;
+	}
+
+	cgltf_size read_size = 0;
+
+	while (read_size < size)
+	{
+		ssize_t result = read(fd, (char*)out_data + read_size, size - read_size);
+
+		if (result <= 0)
+		{
+			close(fd);
+			return cgltf_result_io_error;
+		}
+
+		read_size += (cgltf_size)result;
+	}
+
+	close(fd);
+
+	return cgltf_result_success;
+#else
+	if (offset > LONG_MAX)
+	{
+		return cgltf_result_io_error;
+	}
+
+	FILE* file = fopen(path, "rb");
+	if (!file)
+	{
+		return cgltf_result_file_not_found;
+	}
+
+	cgltf_bool success = fseek(file, (long)offset, SEEK_SET) == 0 && fread(out_data, 1, size, file) == size;
+
+	fclose(file);
+
+	return success ? cgltf_result_success : cgltf_result_io_error;
+#endif
+}
+
+static cgltf_result cgltf_load_buffer_view(cgltf_buffer_view* view)
+{
+	cgltf_buffer* buffer = view->buffer;
+
+	if (view->data || buffer->data || !buffer->lazy_file)
+	{
+		return cgltf_result_success;
+	}
+
+	const cgltf_lazy_file* file = (const cgltf_lazy_file*)buffer->lazy_file;
+	const cgltf_options* options = file->options;
+
+	if (view->size > buffer->size || view->offset > buffer->size - view->size)
+	{
+		return cgltf_result_data_too_short;
+	}
+
+	// File callbacks and mappings provide whole buffers; a mapping still only reads the pages that are touched
+	cgltf_bool whole_buffer = options->file_read != NULL;
+#ifdef CGLTF_MMAP
+	whole_buffer = whole_buffer || options->memory_map;
+#endif
+
+	if (whole_buffer)
+	{
+		void* file_data = NULL;
+		cgltf_size file_size = buffer->size;
+		cgltf_data_free_method free_method = cgltf_data_free_method_none;
+
+		cgltf_result result = cgltf_read_file(options, file->path, 0, &file_size, &file_data, &free_method);
+
+		if (result == cgltf_result_success)
+		{
+			buffer->data = file_data;
+			buffer->data_free_method = free_method;
+		}
+
+		return result;
+	}
+
+	void* view_data = options->memory_alloc(options->memory_user_data, view->size);
+	if (!view_data)
+	{
+		return cgltf_result_out_of_memory;
+	}
+
+	cgltf_result result = cgltf_read_file_range(file->path, view->offset, view->size, view_data);
+
+	if (result != cgltf_result_success)
+	{
+		options->memory_free(options->memory_user_data, view_data);
+		return result;
+	}
+
+	view->data = view_data;
+
+	return cgltf_result_success;
+}
+
+// Returns the bytes of a buffer view that are already in memory, without loading lazily read views
+static const uint8_t* cgltf_buffer_view_bytes(const cgltf_buffer_view* view)
+{
+	if (view->data)
+	{
+		return (const uint8_t*)view->data;
+	}
+
+	return view->buffer->data ? (const uint8_t*)view->buffer->data + view->offset : NULL;
+}
+
+const void* cgltf_buffer_view_data(cgltf_buffer_view* view)
+{
+	if (cgltf_load_buffer_view(view) != cgltf_result_success)
+	{
+		return NULL;
+	}
+
+	return cgltf_buffer_view_bytes(view);
+}
+
+static cgltf_result cgltf_prefetch_accessor(const cgltf_accessor* accessor)
+{
+	cgltf_result result = cgltf_result_success;
+
+	if (accessor && accessor->buffer_view)
+	{
+		result = cgltf_load_buffer_view(accessor->buffer_view);
+	}
+
+	if (result == cgltf_result_success && accessor && accessor->is_sparse)
+	{
+		result = cgltf_load_buffer_view(accessor->sparse.indices_buffer_view);
+
+		if (result == cgltf_result_success)
+		{
+			result = cgltf_load_buffer_view(accessor->sparse.values_buffer_view);
+		}
+	}
+
+	return result;
+}
+
+cgltf_result cgltf_prefetch_meshes(cgltf_mesh* const* meshes, cgltf_size meshes_count)
+{
+	for (cgltf_size i = 0; i < meshes_count; ++i)
+	{
+		for (cgltf_size j = 0; j < meshes[i]->primitives_count; ++j)
+		{
+			const cgltf_primitive* primitive = &meshes[i]->primitives[j];
+
+			cgltf_result result = cgltf_prefetch_accessor(primitive->indices);
+
+			for (cgltf_size k = 0; result == cgltf_result_success && k < primitive->attributes_count; ++k)
+			{
+				result = cgltf_prefetch_accessor(primitive->attributes[k].data);
+			}
+
+			for (cgltf_size t = 0; result == cgltf_result_success && t < primitive->targets_count; ++t)
+			{
+				for (cgltf_size k = 0; result == cgltf_result_success && k < primitive->targets[t].attributes_count; ++k)
+				{
+					result = cgltf_prefetch_accessor(primitive->targets[t].attributes[k].data);
+				}
+			}
+
+			if (result != cgltf_result_success)
+			{
+				return result;
+			}
+		}
+	}
+
+	return cgltf_result_success;
+}
+
+static cgltf_result cgltf_densify_sparse(const cgltf_options* options, cgltf_accessor* accessor);
+
+static cgltf_result cgltf_densify_sparse_accessors(const cgltf_options* options, cgltf_data* data)
+{
+	if (!options->densify_sparse)
+	{
+		return cgltf_result_success;
+	}
+
+	for (cgltf_size i = 0; i < data->accessors_count; ++i)
+	{
+		cgltf_accessor* accessor = &data->accessors[i];
+
+		if (accessor->is_sparse && accessor->sparse_data == NULL)
+		{
+			// Lazily loaded buffers only read the views of sparse accessors, which are usually small
+			cgltf_result result = cgltf_prefetch_accessor(accessor);
+
+			if (result == cgltf_result_success)
+			{
+				result = cgltf_densify_sparse(options, accessor);
+			}
+
+			if (result != cgltf_result_success)
+			{
+				return result;
+			}
+		}
+	}
+
+	return cgltf_result_success;
+}
+
+static cgltf_size cgltf_calc_size(cgltf_type type, cgltf_component_type component_type);
+
+#if defined(CGLTF_SSE2) && !defined(CGLTF_AVX2)
+/* SSE2 has no unsigned 32-bit max, so indices are compared with their sign bit flipped */
+static __m128i cgltf_max_epi32(__m128i a, __m128i b)
+{
+	__m128i gt = _mm_cmpgt_epi32(a, b);
+	return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+}
+#endif
+
+static cgltf_size cgltf_calc_index_bound_8u(const uint8_t* data, cgltf_size count)
+{
+	cgltf_size bound = 0;
+	cgltf_size i = 0;
+
+#if defined(CGLTF_SSE2)
+	__m128i m = _mm_setzero_si128();
+#if defined(CGLTF_AVX2)
+	__m256i m8 = _mm256_setzero_si256();
+	for (; i + 32 <= count; i += 32)
+	{
+		m8 = _mm256_max_epu8(m8, _mm256_loadu_si256((const __m256i*)(data + i)));
+	}
+	m = _mm_max_epu8(_mm256_castsi256_si128(m8), _mm256_extracti128_si256(m8, 1));
+#endif
+	for (; i + 16 <= count; i += 16)
+	{
+		m = _mm_max_epu8(m, _mm_loadu_si128((const __m128i*)(data + i)));
+	}
+	uint8_t lanes[16];
+	_mm_storeu_si128((__m128i*)lanes, m);
+	for (int k = 0; k < 16; ++k)
+	{
+		bound = bound > lanes[k] ? bound : lanes[k];
+	}
+#elif defined(CGLTF_NEON)
+	uint8x16_t m = vdupq_n_u8(0);
+	for (; i + 16 <= count; i += 16)
+	{
+		m = vmaxq_u8(m, vld1q_u8(data + i));
+	}
+	bound = vmaxvq_u8(m);
+#endif
+
+	for (; i < count; ++i)
+	{
+		cgltf_size v = data[i];
+		bound = bound > v ? bound : v;
+	}
+
+	return bound;
+}
+
+static cgltf_size cgltf_calc_index_bound_16u(const uint8_t* data, cgltf_size count)
+{
+	cgltf_size bound = 0;
+	cgltf_size i = 0;
+
+#if defined(CGLTF_AVX2)
+	__m256i m16 = _mm256_setzero_si256();
+	for (; i + 16 <= count; i += 16)
+	{
+		m16 = _mm256_max_epu16(m16, _mm256_loadu_si256((const __m256i*)(data + i * 2)));
+	}
+	__m128i m = _mm_max_epu16(_mm256_castsi256_si128(m16), _mm256_extracti128_si256(m16, 1));
+	for (; i + 8 <= count; i += 8)
+	{
+		m = _mm_max_epu16(m, _mm_loadu_si128((const __m128i*)(data + i * 2)));
+	}
+	uint16_t lanes[8];
+	_mm_storeu_si128((__m128i*)lanes, m);
+	for (int k = 0; k < 8; ++k)
+	{
+		bound = bound > lanes[k] ? bound : lanes[k];
+	}
+#elif defined(CGLTF_SSE2)
+	/* SSE2 only has a signed 16-bit max, so indices are compared with their sign bit flipped */
+	const __m128i bias = _mm_set1_epi16(-32768);
+	__m128i m = bias;
+	for (; i + 8 <= count; i += 8)
+	{
+		m = _mm_max_epi16(m, _mm_xor_si128(_mm_loadu_si128((const __m128i*)(data + i * 2)), bias));
+	}
+	uint16_t lanes[8];
+	_mm_storeu_si128((__m128i*)lanes, _mm_xor_si128(m, bias));
+	for (int k = 0; k < 8; ++k)
+	{
+		bound = bound > lanes[k] ? bound : lanes[k];
+	}
+#elif defined(CGLTF_NEON)
+	uint16x8_t m = vdupq_n_u16(0);
+	for (; i + 8 <= count; i += 8)
+	{
+		m = vmaxq_u16(m, vreinterpretq_u16_u8(vld1q_u8(data + i * 2)));
+	}
+	bound = vmaxvq_u16(m);
+#endif
+
+	for (; i < count; ++i)
+	{
+		cgltf_size v = ((const unsigned short*)data)[i];
+		bound = bound > v ? bound : v;
+	}
+
+	return bound;
+}
+
+static cgltf_size cgltf_calc_index_bound_32u(const uint8_t* data, cgltf_size count)
+{
+	cgltf_size bound = 0;
+	cgltf_size i = 0;
+
+#if defined(CGLTF_AVX2)
+	__m256i m32 = _mm256_setzero_si256();
+	for (; i + 8 <= count; i += 8)
+	{
+		m32 = _mm256_max_epu32(m32, _mm256_loadu_si256((const __m256i*)(data + i * 4)));
+	}
+	uint32_t lanes[8];
+	_mm256_storeu_si256((__m256i*)lanes, m32);
+	for (int k = 0; k < 8; ++k)
+	{
+		bound = bound > lanes[k] ? bound : lanes[k];
+	}
+#elif defined(CGLTF_SSE2)
+	const __m128i bias = _mm_set1_epi32((int)0x80000000u);
+	__m128i m = bias;
+	for (; i + 4 <= count; i += 4)
+	{
+		m = cgltf_max_epi32(m, _mm_xor_si128(_mm_loadu_si128((const __m128i*)(data + i * 4)), bias));
+	}
+	uint32_t lanes[4];
+	_mm_storeu_si128((__m128i*)lanes, _mm_xor_si128(m, bias));
+	for (int k = 0; k < 4; ++k)
+	{
+		bound = bound > lanes[k] ? bound : lanes[k];
+	}
+#elif defined(CGLTF_NEON)
+	uint32x4_t m = vdupq_n_u32(0);
+	for (; i + 4 <= count; i += 4)
+	{
+		m = vmaxq_u32(m, vreinterpretq_u32_u8(vld1q_u8(data + i * 4)));
+	}
+	bound = vmaxvq_u32(m);
+#endif
+
+	for (; i < count; ++i)
+	{
+		cgltf_size v = ((const unsigned int*)data)[i];
+		bound = bound > v ? bound : v;
+	}
+
+	return bound;
+}
+
+static cgltf_size cgltf_calc_index_bound(cgltf_buffer_view* buffer_view, cgltf_size offset, cgltf_component_type component_type, cgltf_size count)
+{
+	const uint8_t* data = cgltf_buffer_view_bytes(buffer_view) + offset;
+
+	switch (component_type)
+	{
+	case cgltf_component_type_r_8u:
+		return cgltf_calc_index_bound_8u(data, count);
+
+	case cgltf_component_type_r_16u:
+		return cgltf_calc_index_bound_16u(data, count);
+
+	case cgltf_component_type_r_32u:
+		return cgltf_calc_index_bound_32u(data, count);
+
+	default:
+		return 0;
+	}
+}
+
+#ifdef CGLTF_PTHREADS
+typedef struct cgltf_task_queue
+{
+	void (*task)(void* task_data, cgltf_size task_index);
+	void* task_data;
+	cgltf_size task_count;
+	cgltf_size next_task;
+	pthread_mutex_t mutex;
+} cgltf_task_queue;
+
+static void* cgltf_task_worker(void* arg)
+{
+	cgltf_task_queue* queue = (cgltf_task_queue*)arg;
+
+	for (;;)
+	{
+		pthread_mutex_lock(&queue->mutex);
+		cgltf_size task_index = queue->next_task++;
+		pthread_mutex_unlock(&queue->mutex);
+
+		if (task_index >= queue->task_count)
+		{
+			return NULL;
+		}
+
+		queue->task(queue->task_data, task_index);
+	}
+}
+#endif
+
+static void cgltf_run_tasks(const cgltf_options* options, cgltf_size task_count, void (*task)(void* task_data, cgltf_size task_index), void* task_data)
+{
+	if (task_count == 0)
+	{
+		return;
+	}
+
+	if (options->run_tasks)
+	{
+		options->run_tasks(options->tasks_user_data, task_count, task, task_data);
+		return;
+	}
+
+#ifdef CGLTF_PTHREADS
+	cgltf_size thread_count = options->thread_count < task_count ? options->thread_count : task_count;
+
+	if (thread_count > 1)
+	{
+		void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
+		void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+
+		pthread_t* threads = (pthread_t*)memory_alloc(options->memory_user_data, (thread_count - 1) * sizeof(pthread_t));
+
+		if (threads)
+		{
+			cgltf_task_queue queue;
+			queue.task = task;
+			queue.task_data = task_data;
+			queue.task_count = task_count;
+			queue.next_task = 0;
+			pthread_mutex_init(&queue.mutex, NULL);
+
+			// The calling thread works on the queue too, so all tasks finish even if no thread could be started
+			cgltf_size started = 0;
+			while (started < thread_count - 1 && pthread_create(&threads[started], NULL, &cgltf_task_worker, &queue) == 0)
+			{
+				++started;
+			}
+
+			cgltf_task_worker(&queue);
+
+			for (cgltf_size i = 0; i < started; ++i)
+			{
+				pthread_join(threads[i], NULL);
+			}
+
+			pthread_mutex_destroy(&queue.mutex);
+			memory_free(options->memory_user_data, threads);
+			return;
+		}
+	}
+#endif
+
+	for (cgltf_size i = 0; i < task_count; ++i)
+	{
+		task(task_data, i);
+	}
+}
+
+typedef struct cgltf_validate_context
+{
+	cgltf_data* data;
+	cgltf_size* index_bounds; /* per accessor: 0 == not used as indices, (cgltf_size)-1 == not computed yet, otherwise 1 + largest index */
+	cgltf_result* chunk_results;
+	cgltf_result (*validate)(struct cgltf_validate_context* context, cgltf_size index);
+	cgltf_size count;
+	cgltf_size chunk_size;
+} cgltf_validate_context;
+
+static cgltf_result cgltf_validate_accessor(cgltf_validate_context* context, cgltf_size index)
+{
+	cgltf_accessor* accessor = &context->data->accessors[index];
+
+	cgltf_size element_size = cgltf_calc_size(accessor->type, accessor->component_type);
+
+	if (accessor->buffer_view)
+	{
+		cgltf_size req_size = accessor->offset + accessor->stride * (accessor->count - 1) + element_size;
+
+		if (accessor->buffer_view->size < req_size)
+		{
+			return cgltf_result_data_too_short;
+		}
+	}
+
+	if (accessor->is_sparse)
+	{
+		cgltf_accessor_sparse* sparse = &accessor->sparse;
+
+		cgltf_size indices_component_size = cgltf_calc_size(cgltf_type_scalar, sparse->indices_component_type);
+		cgltf_size indices_req_size = sparse->indices_byte_offset + indices_component_size * sparse->count;
+		cgltf_size values_req_size = sparse->values_byte_offset + element_size * sparse->count;
+
+		if (sparse->indices_buffer_view->size < indices_req_size ||
+			sparse->values_buffer_view->size < values_req_size)
+		{
+			return cgltf_result_data_too_short;
+		}
+
+		if (sparse->indices_component_type != cgltf_component_type_r_8u &&
+			sparse->indices_component_type != cgltf_component_type_r_16u &&
+			sparse->indices_component_type != cgltf_component_type_r_32u)
+		{
+			return cgltf_result_invalid_gltf;
+		}
+
+		if (cgltf_buffer_view_bytes(sparse->indices_buffer_view))
+		{
+			cgltf_size index_bound = cgltf_calc_index_bound(sparse->indices_buffer_view, sparse->indices_byte_offset, sparse->indices_component_type, sparse->count);
+
+			if (index_bound >= accessor->count)
+			{
+				return cgltf_result_data_too_short;
+			}
+		}
+	}
+
+	return cgltf_result_success;
+}
+
+static cgltf_result cgltf_validate_buffer_view(cgltf_validate_context* context, cgltf_size index)
+{
+	cgltf_buffer_view* buffer_view = &context->data->buffer_views[index];
+
+	cgltf_size req_size = buffer_view->offset + buffer_view->size;
+
+	if (buffer_view->buffer && buffer_view->buffer->size < req_size)
+	{
+		return cgltf_result_data_too_short;
+	}
+
+	return cgltf_result_success;
+}
+
+static cgltf_result cgltf_validate_mesh(cgltf_validate_context* context, cgltf_size index)
+{
+	cgltf_mesh* mesh = &context->data->meshes[index];
+
+	if (mesh->weights)
+	{
+		if (mesh->primitives_count && mesh->primitives[0].targets_count != mesh->weights_count)
+		{
+			return cgltf_result_invalid_gltf;
+		}
+	}
+
+	for (cgltf_size j = 0; j < mesh->primitives_count; ++j)
+	{
+		if (mesh->primitives[j].targets_count != mesh->primitives[0].targets_count)
+		{
+			return cgltf_result_invalid_gltf;
+		}
+
+		if (mesh->primitives[j].attributes_count)
+		{
+			cgltf_accessor* first = mesh->primitives[j].attributes[0].data;
+
+			for (cgltf_size k = 0; k < mesh->primitives[j].attributes_count; ++k)
+			{
+				if (mesh->primitives[j].attributes[k].data->count != first->count)
+				{
+					return cgltf_result_invalid_gltf;
+				}
+			}
+
+			for (cgltf_size k = 0; k < mesh->primitives[j].targets_count; ++k)
+			{
+				for (cgltf_size m = 0; m < mesh->primitives[j].targets[k].attributes_count; ++m)
+				{
+					if (mesh->primitives[j].targets[k].attributes[m].data->count != first->count)
+					{
+						return cgltf_result_invalid_gltf;
+					}
+				}
+			}
+
+			cgltf_accessor* indices = mesh->primitives[j].indices;
+
+			if (indices &&
+				indices->component_type != cgltf_component_type_r_8u &&
+				indices->component_type != cgltf_component_type_r_16u &&
+				indices->component_type != cgltf_component_type_r_32u)
+			{
+				return cgltf_result_invalid_gltf;
+			}
+		}
+	}
+
+	return cgltf_result_success;
+}
+
+static cgltf_result cgltf_validate_index_bound(cgltf_validate_context* context, cgltf_size index)
+{
+	cgltf_accessor* indices = &context->data->accessors[index];
+
+	if (context->index_bounds[index] == (cgltf_size)-1)
+	{
+		context->index_bounds[index] = cgltf_calc_index_bound(indices->buffer_view, indices->offset, indices->component_type, indices->count) + 1;
+	}
+
+	return cgltf_result_success;
+}
+
+static cgltf_result cgltf_validate_node(cgltf_validate_context* context, cgltf_size index)
+{
+	cgltf_node* node = &context->data->nodes[index];
+
+	if (node->weights && node->mesh)
+	{
+		if (node->mesh->primitives_count && node->mesh->primitives[0].targets_count != node->weights_count)
+		{
+			return cgltf_result_invalid_gltf;
+		}
+	}
+
+	return cgltf_result_success;
+}
+
+static void cgltf_validate_chunk(void* task_data, cgltf_size chunk)
+{
+	cgltf_validate_context* context = (cgltf_validate_context*)task_data;
+
+	cgltf_size begin = chunk * context->chunk_size;
+	cgltf_size end = context->count - begin < context->chunk_size ? context->count : begin + context->chunk_size;
+
+	cgltf_result result = cgltf_result_success;
+
+	for (cgltf_size i = begin; i < end && result == cgltf_result_success; ++i)
+	{
+		result = context->validate(context, i);
+	}
+
+	context->chunk_results[chunk] = result;
+}
+
+static cgltf_result cgltf_validate_range(const cgltf_options* options, cgltf_validate_context* context, cgltf_size count, cgltf_size chunk_size, cgltf_result (*validate)(cgltf_validate_context* context, cgltf_size index))
+{
+	context->validate = validate;
+	context->count = count;
+	context->chunk_size = chunk_size;
+
+	cgltf_size chunk_count = (count + chunk_size - 1) / chunk_size;
+
+	cgltf_run_tasks(options, chunk_count, &cgltf_validate_chunk, context);
+
+	// Chunks cover the elements in order, so the first failing chunk has the error a serial sweep would find first
+	for (cgltf_size i = 0; i < chunk_count; ++i)
+	{
+		if (context->chunk_results[i] != cgltf_result_success)
+		{
+			return context->chunk_results[i];
+		}
+	}
+
+	return cgltf_result_success;
+}
+
+static cgltf_result cgltf_validate_index_bounds(const cgltf_options* options, cgltf_validate_context* context)
+{
+	cgltf_data* data = context->data;
+
+	memset(context->index_bounds, 0, data->accessors_count * sizeof(cgltf_size));
+
+	for (cgltf_size i = 0; i < data->meshes_count; ++i)
+	{
+		for (cgltf_size j = 0; j < data->meshes[i].primitives_count; ++j)
+		{
+			cgltf_primitive* primitive = &data->meshes[i].primitives[j];
+			cgltf_accessor* indices = primitive->indices;
+
+			if (primitive->attributes_count && indices && indices->buffer_view && cgltf_buffer_view_bytes(indices->buffer_view))
+			{
+				context->index_bounds[indices - data->accessors] = (cgltf_size)-1;
+			}
+		}
+	}
+
+	// Each indices accessor is scanned once, even if many primitives share it
+	cgltf_validate_range(options, context, data->accessors_count, 1, &cgltf_validate_index_bound);
+
+	for (cgltf_size i = 0; i < data->meshes_count; ++i)
+	{
+		for (cgltf_size j = 0; j < data->meshes[i].primitives_count; ++j)
+		{
+			cgltf_primitive* primitive = &data->meshes[i].primitives[j];
+			cgltf_accessor* indices = primitive->indices;
+
+			if (primitive->attributes_count && indices && indices->buffer_view && cgltf_buffer_view_bytes(indices->buffer_view) &&
+				context->index_bounds[indices - data->accessors] > primitive->attributes[0].data->count)
+			{
+				return cgltf_result_data_too_short;
+			}
+		}
+	}
+
+	return cgltf_result_success;
+}
+
+cgltf_result cgltf_validate_parallel(const cgltf_options* options, cgltf_data* data)
+{
+	if (options == NULL)
+	{
+		return cgltf_result_invalid_options;
+	}
+
+	void* (*memory_alloc)(void*, cgltf_size) = data->memory_alloc ? data->memory_alloc : &cgltf_default_alloc;
+	void (*memory_free)(void*, void*) = data->memory_free ? data->memory_free : &cgltf_default_free;
+
+	cgltf_size max_count = data->accessors_count;
+	max_count = data->buffer_views_count > max_count ? data->buffer_views_count : max_count;
+	max_count = data->meshes_count > max_count ? data->meshes_count : max_count;
+	max_count = data->nodes_count > max_count ? data->nodes_count : max_count;
+
+	if (max_count == 0)
+	{
+		return cgltf_result_success;
+	}
+
+	cgltf_validate_context context;
+	memset(&context, 0, sizeof(context));
+	context.data = data;
+	context.index_bounds = (cgltf_size*)memory_alloc(data->memory_user_data, data->accessors_count * sizeof(cgltf_size) + max_count * sizeof(cgltf_result));
+
+	if (!context.index_bounds)
+	{
+		return cgltf_result_out_of_memory;
+	}
+
+	context.chunk_results = (cgltf_result*)(context.index_bounds + data->accessors_count);
+
+	cgltf_result result = cgltf_validate_range(options, &context, data->accessors_count, 64, &cgltf_validate_accessor);
+
+	if (result == cgltf_result_success)
+	{
+		result = cgltf_validate_range(options, &context, data->buffer_views_count, 1024, &cgltf_validate_buffer_view);
+	}
+
+	if (result == cgltf_result_success)
+	{
+		result = cgltf_validate_range(options, &context, data->meshes_count, 64, &cgltf_validate_mesh);
+	}
+
+	if (result == cgltf_result_success)
+	{
+		result = cgltf_validate_index_bounds(options, &context);
+	}
+
+	if (result == cgltf_result_success)
+	{
+		result = cgltf_validate_range(options, &context, data->nodes_count, 1024, &cgltf_validate_node);
+	}
+
+	memory_free(data->memory_user_data, context.index_bounds);
+	return result;
+}
+
+cgltf_result cgltf_validate(cgltf_data* data)
+{
+	cgltf_options options;
+	memset(&options, 0, sizeof(options));
+
+	return cgltf_validate_parallel(&options, data);
+}
+
+cgltf_result cgltf_copy_extras_json(const cgltf_data* data, const cgltf_extras* extras, char* dest, cgltf_size* dest_size)
+{
+	cgltf_size json_size = extras->end_offset - extras->start_offset;
+
+	if (!dest)
+	{
+		if (dest_size)
+		{
+			*dest_size = json_size + 1;
+			return cgltf_result_success;
+		}
+		return cgltf_result_invalid_options;
+	}
 
 	if (*dest_size + 1 < json_size)
 	{
-		strncpy(dest, data->json + extras->start_offset, *dest_size - 1);
-		dest[*dest_size - 1] = 0;
+		strncpy(dest, data->json + extras->start_offset, *dest_size - 1);
+		dest[*dest_size - 1] = 0;
+	}
+	else
+	{
+		strncpy(dest, data->json + extras->start_offset, json_size);
+		dest[json_size] = 0;
+	}
+
+	return cgltf_result_success;
+}
+
+typedef struct cgltf_name_table
+{
+	cgltf_size* slots; /* 0 == empty, otherwise 1 + object index */
+	cgltf_size capacity; /* power of two */
+} cgltf_name_table;
+
+typedef struct cgltf_name_index
+{
+	cgltf_name_table nodes;
+	cgltf_name_table meshes;
+	cgltf_name_table materials;
+	cgltf_name_table animations;
+} cgltf_name_index;
+
+static cgltf_size cgltf_hash_name(const char* name)
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+
+	for (; *name; ++name)
+	{
+		hash ^= (uint8_t)*name;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+static const char* cgltf_object_name(const void* objects, cgltf_size stride, cgltf_size name_offset, cgltf_size index)
+{
+	const char* const* name = (const char* const*)((const uint8_t*)objects + stride * index + name_offset);
+	return *name;
+}
+
+static cgltf_size cgltf_name_table_capacity(cgltf_size count)
+{
+	// Keep the load factor at or below 50% so that probe sequences stay short
+	cgltf_size capacity = 1;
+
+	while (capacity < count * 2)
+	{
+		capacity *= 2;
+	}
+
+	return count ? capacity : 0;
+}
+
+static cgltf_size* cgltf_init_name_table(cgltf_name_table* table, cgltf_size* slots, const void* objects, cgltf_size count, cgltf_size stride, cgltf_size name_offset)
+{
+	table->slots = slots;
+	table->capacity = cgltf_name_table_capacity(count);
+
+	memset(slots, 0, table->capacity * sizeof(cgltf_size));
+
+	for (cgltf_size i = 0; i < count; ++i)
+	{
+		const char* name = cgltf_object_name(objects, stride, name_offset, i);
+
+		if (!name)
+		{
+			continue;
+		}
+
+		cgltf_size slot = cgltf_hash_name(name) & (table->capacity - 1);
+
+		// Objects are inserted in order, so the first one with a duplicate name keeps its slot
+		while (slots[slot] && strcmp(cgltf_object_name(objects, stride, name_offset, slots[slot] - 1), name) != 0)
+		{
+			slot = (slot + 1) & (table->capacity - 1);
+		}
+
+		if (!slots[slot])
+		{
+			slots[slot] = i + 1;
+		}
+	}
+
+	return slots + table->capacity;
+}
+
+static cgltf_bool cgltf_build_name_index(cgltf_options* options, cgltf_data* data)
+{
+	cgltf_size slot_count =
+		cgltf_name_table_capacity(data->nodes_count) +
+		cgltf_name_table_capacity(data->meshes_count) +
+		cgltf_name_table_capacity(data->materials_count) +
+		cgltf_name_table_capacity(data->animations_count);
+
+	cgltf_name_index* index = (cgltf_name_index*)options->memory_alloc(options->memory_user_data, sizeof(cgltf_name_index) + slot_count * sizeof(cgltf_size));
+
+	if (!index)
+	{
+		return 0;
+	}
+
+	cgltf_size* slots = (cgltf_size*)(index + 1);
+	slots = cgltf_init_name_table(&index->nodes, slots, data->nodes, data->nodes_count, sizeof(cgltf_node), offsetof(cgltf_node, name));
+	slots = cgltf_init_name_table(&index->meshes, slots, data->meshes, data->meshes_count, sizeof(cgltf_mesh), offsetof(cgltf_mesh, name));
+	slots = cgltf_init_name_table(&index->materials, slots, data->materials, data->materials_count, sizeof(cgltf_material), offsetof(cgltf_material, name));
+	cgltf_init_name_table(&index->animations, slots, data->animations, data->animations_count, sizeof(cgltf_animation), offsetof(cgltf_animation, name));
+
+	data->name_index = index;
+	return 1;
+}
+
+static void* cgltf_find_by_name(const cgltf_name_table* table, void* objects, cgltf_size count, cgltf_size stride, cgltf_size name_offset, const char* name)
+{
+	if (!name)
+	{
+		return NULL;
+	}
+
+	if (!table)
+	{
+		for (cgltf_size i = 0; i < count; ++i)
+		{
+			const char* object_name = cgltf_object_name(objects, stride, name_offset, i);
+
+			if (object_name && strcmp(object_name, name) == 0)
+			{
+				return (uint8_t*)objects + stride * i;
+			}
+		}
+
+		return NULL;
+	}
+
+	if (!table->capacity)
+	{
+		return NULL;
+	}
+
+	cgltf_size slot = cgltf_hash_name(name) & (table->capacity - 1);
+
+	for (; table->slots[slot]; slot = (slot + 1) & (table->capacity - 1))
+	{
+		if (strcmp(cgltf_object_name(objects, stride, name_offset, table->slots[slot] - 1), name) == 0)
+		{
+			return (uint8_t*)objects + stride * (table->slots[slot] - 1);
+		}
+	}
+
+	return NULL;
+}
+
+cgltf_node* cgltf_find_node_by_name(const cgltf_data* data, const char* name)
+{
+	const cgltf_name_index* index = (const cgltf_name_index*)data->name_index;
+	return (cgltf_node*)cgltf_find_by_name(index ? &index->nodes : NULL, data->nodes, data->nodes_count, sizeof(cgltf_node), offsetof(cgltf_node, name), name);
+}
+
+cgltf_mesh* cgltf_find_mesh_by_name(const cgltf_data* data, const char* name)
+{
+	const cgltf_name_index* index = (const cgltf_name_index*)data->name_index;
+	return (cgltf_mesh*)cgltf_find_by_name(index ? &index->meshes : NULL, data->meshes, data->meshes_count, sizeof(cgltf_mesh), offsetof(cgltf_mesh, name), name);
+}
+
+cgltf_material* cgltf_find_material_by_name(const cgltf_data* data, const char* name)
+{
+	const cgltf_name_index* index = (const cgltf_name_index*)data->name_index;
+	return (cgltf_material*)cgltf_find_by_name(index ? &index->materials : NULL, data->materials, data->materials_count, sizeof(cgltf_material), offsetof(cgltf_material, name), name);
+}
+
+cgltf_animation* cgltf_find_animation_by_name(const cgltf_data* data, const char* name)
+{
+	const cgltf_name_index* index = (const cgltf_name_index*)data->name_index;
+	return (cgltf_animation*)cgltf_find_by_name(index ? &index->animations : NULL, data->animations, data->animations_count, sizeof(cgltf_animation), offsetof(cgltf_animation, name), name);
+}
+
+static void cgltf_free_string(cgltf_data* data, char* string)
+{
+	if (!data->in_place_strings)
+	{
+		data->memory_free(data->memory_user_data, string);
+	}
+}
+
+void cgltf_free(cgltf_data* data)
+{
+	if (!data)
+	{
+		return;
+	}
+
+	for (cgltf_size i = 0; i < data->buffers_count; ++i)
+	{
+		switch (data->buffers[i].data_free_method)
+		{
+		case cgltf_data_free_method_memory_free:
+			data->memory_free(data->memory_user_data, data->buffers[i].data);
+			break;
+
+		case cgltf_data_free_method_munmap:
+#ifdef CGLTF_MMAP
+			munmap(data->buffers[i].data, data->buffers[i].size);
+#endif
+			break;
+
+		case cgltf_data_free_method_file_release:
+			data->file_release(data->file_user_data, data->buffers[i].data);
+			break;
+
+		default:
+			;
+		}
+	}
+
+	for (cgltf_size i = 0; i < data->accessors_count; ++i)
+	{
+		data->memory_free(data->memory_user_data, data->accessors[i].sparse_data);
+	}
+
+	for (cgltf_size i = 0; i < data->images_count; ++i)
+	{
+		data->memory_free(data->memory_user_data, data->images[i].data);
+	}
+
+	for (cgltf_size i = 0; i < data->buffer_views_count; ++i)
+	{
+		data->memory_free(data->memory_user_data, data->buffer_views[i].data);
+	}
+
+	data->memory_free(data->memory_user_data, data->lazy_files);
+
+	data->memory_free(data->memory_user_data, data->name_index);
+
+	if (data->file_data_mapped)
+	{
+#ifdef CGLTF_MMAP
+		munmap(data->file_data, data->file_size);
+#endif
+	}
+	else if (data->file_data_released)
+	{
+		data->file_release(data->file_user_data, data->file_data);
+	}
+	else
+	{
+		data->memory_free(data->memory_user_data, data->file_data);
+	}
+
+	if (data->arena)
+	{
+		cgltf_arena_block* block = (cgltf_arena_block*)data->arena;
+
+		while (block)
+		{
+			cgltf_arena_block* next = block->next;
+			data->memory_free(data->memory_user_data, block);
+			block = next;
+		}
+
+		data->memory_free(data->memory_user_data, data);
+		return;
+	}
+
+	cgltf_free_string(data, data->asset.copyright);
+	cgltf_free_string(data, data->asset.generator);
+	cgltf_free_string(data, data->asset.version);
+	cgltf_free_string(data, data->asset.min_version);
+
+	data->memory_free(data->memory_user_data, data->accessors);
+	data->memory_free(data->memory_user_data, data->buffer_views);
+
+	for (cgltf_size i = 0; i < data->buffers_count; ++i)
+	{
+		cgltf_free_string(data, data->buffers[i].uri);
+	}
+
+	data->memory_free(data->memory_user_data, data->buffers);
+
+	for (cgltf_size i = 0; i < data->meshes_count; ++i)
+	{
+		cgltf_free_string(data, data->meshes[i].name);
+
+		for (cgltf_size j = 0; j < data->meshes[i].primitives_count; ++j)
+		{
+			for (cgltf_size k = 0; k < data->meshes[i].primitives[j].attributes_count; ++k)
+			{
+				cgltf_free_string(data, data->meshes[i].primitives[j].attributes[k].name);
+			}
+
+			data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].attributes);
+
+			for (cgltf_size k = 0; k < data->meshes[i].primitives[j].targets_count; ++k)
+			{
+				for (cgltf_size m = 0; m < data->meshes[i].primitives[j].targets[k].attributes_count; ++m)
+				{
+					cgltf_free_string(data, data->meshes[i].primitives[j].targets[k].attributes[m].name);
+				}
+
+				data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].targets[k].attributes);
+			}
+
+			data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].targets);
+		}
+
+		data->memory_free(data->memory_user_data, data->meshes[i].primitives);
+		data->memory_free(data->memory_user_data, data->meshes[i].weights);
+	}
+
+	data->memory_free(data->memory_user_data, data->meshes);
+
+	for (cgltf_size i = 0; i < data->materials_count; ++i)
+	{
+		cgltf_free_string(data, data->materials[i].name);
+	}
+
+	data->memory_free(data->memory_user_data, data->materials);
+
+	for (cgltf_size i = 0; i < data->images_count; ++i) 
+	{
+		cgltf_free_string(data, data->images[i].name);
+		cgltf_free_string(data, data->images[i].uri);
+		cgltf_free_string(data, data->images[i].mime_type);
+	}
+
+	data->memory_free(data->memory_user_data, data->images);
+
+	for (cgltf_size i = 0; i < data->textures_count; ++i)
+	{
+		cgltf_free_string(data, data->textures[i].name);
+	}
+
+	data->memory_free(data->memory_user_data, data->textures);
+
+	data->memory_free(data->memory_user_data, data->samplers);
+
+	for (cgltf_size i = 0; i < data->skins_count; ++i)
+	{
+		cgltf_free_string(data, data->skins[i].name);
+		data->memory_free(data->memory_user_data, data->skins[i].joints);
+	}
+
+	data->memory_free(data->memory_user_data, data->skins);
+
+	for (cgltf_size i = 0; i < data->cameras_count; ++i)
+	{
+		cgltf_free_string(data, data->cameras[i].name);
+	}
+
+	data->memory_free(data->memory_user_data, data->cameras);
+
+	for (cgltf_size i = 0; i < data->lights_count; ++i)
+	{
+		cgltf_free_string(data, data->lights[i].name);
+	}
+
+	data->memory_free(data->memory_user_data, data->lights);
+
+	for (cgltf_size i = 0; i < data->nodes_count; ++i)
+	{
+		cgltf_free_string(data, data->nodes[i].name);
+		data->memory_free(data->memory_user_data, data->nodes[i].children);
+		data->memory_free(data->memory_user_data, data->nodes[i].weights);
+	}
+
+	data->memory_free(data->memory_user_data, data->nodes);
+
+	for (cgltf_size i = 0; i < data->scenes_count; ++i)
+	{
+		cgltf_free_string(data, data->scenes[i].name);
+		data->memory_free(data->memory_user_data, data->scenes[i].nodes);
+	}
+
+	data->memory_free(data->memory_user_data, data->scenes);
+
+	for (cgltf_size i = 0; i < data->animations_count; ++i)
+	{
+		cgltf_free_string(data, data->animations[i].name);
+		data->memory_free(data->memory_user_data, data->animations[i].samplers);
+		data->memory_free(data->memory_user_data, data->animations[i].channels);
+	}
+
+	data->memory_free(data->memory_user_data, data->animations);
+
+	for (cgltf_size i = 0; i < data->extensions_used_count; ++i)
+	{
+		cgltf_free_string(data, data->extensions_used[i]);
+	}
+
+	data->memory_free(data->memory_user_data, data->extensions_used);
+
+	for (cgltf_size i = 0; i < data->extensions_required_count; ++i)
+	{
+		cgltf_free_string(data, data->extensions_required[i]);
+	}
+
+	data->memory_free(data->memory_user_data, data->extensions_required);
+
+	data->memory_free(data->memory_user_data, data);
+}
+
+#if defined(CGLTF_SSE2)
+#define CGLTF_SHUFFLE_PS(v, x, y, z) _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, z, y, x))
+#elif defined(CGLTF_NEON)
+static float32x4_t cgltf_shuffle_neon(float32x4_t v, uint32_t x, uint32_t y, uint32_t z)
+{
+	/* table lookup with the byte offsets of lanes x, y, z and 3 */
+	const uint32_t lanes[4] = { x * 0x04040404u + 0x03020100u, y * 0x04040404u + 0x03020100u, z * 0x04040404u + 0x03020100u, 0x0f0e0d0cu };
+	return vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(v), vreinterpretq_u8_u32(vld1q_u32(lanes))));
+}
+
+#define CGLTF_SHUFFLE_PS(v, x, y, z) cgltf_shuffle_neon(v, x, y, z)
+#endif
+
+void cgltf_node_transform_local(const cgltf_node* node, cgltf_float* out_matrix)
+{
+	cgltf_float* lm = out_matrix;
+
+	if (node->has_matrix)
+	{
+		memcpy(lm, node->matrix, sizeof(float) * 16);
+	}
+	else
+	{
+#if defined(CGLTF_SSE2) || defined(CGLTF_NEON)
+		/* every rotation row is (k + a * b + c * d) * scale, with the signs folded into the products and
+		 * k being 1 on the diagonal and -0 elsewhere, which evaluates in the same order as the scalar code */
+#if defined(CGLTF_SSE2)
+		const __m128 q = _mm_loadu_ps(node->rotation);
+		const __m128 q2 = _mm_add_ps(q, q);
+		const __m128 scale = _mm_setr_ps(node->scale[0], node->scale[1], node->scale[2], 0.f);
+		const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+#define CGLTF_TRS_ROW(k0, k1, k2, sp0, sp1, sp2, sq0, sq1, sq2, a, b, c, d) \
+	_mm_and_ps(_mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_setr_ps(k0, k1, k2, 0.f), \
+		_mm_xor_ps(_mm_mul_ps(a, b), _mm_setr_ps(sp0, sp1, sp2, 0.f))), \
+		_mm_xor_ps(_mm_mul_ps(c, d), _mm_setr_ps(sq0, sq1, sq2, 0.f))), scale), mask)
+
+		_mm_storeu_ps(lm + 0, CGLTF_TRS_ROW(1.f, -0.f, -0.f, -0.f, 0.f, 0.f, -0.f, 0.f, -0.f,
+			CGLTF_SHUFFLE_PS(q2, 1, 0, 0), CGLTF_SHUFFLE_PS(q, 1, 1, 2), CGLTF_SHUFFLE_PS(q2, 2, 2, 1), CGLTF_SHUFFLE_PS(q, 2, 3, 3)));
+		_mm_storeu_ps(lm + 4, CGLTF_TRS_ROW(-0.f, 1.f, -0.f, 0.f, -0.f, 0.f, -0.f, -0.f, 0.f,
+			CGLTF_SHUFFLE_PS(q2, 0, 0, 1), CGLTF_SHUFFLE_PS(q, 1, 0, 2), CGLTF_SHUFFLE_PS(q2, 2, 2, 0), CGLTF_SHUFFLE_PS(q, 3, 2, 3)));
+		_mm_storeu_ps(lm + 8, CGLTF_TRS_ROW(-0.f, -0.f, 1.f, 0.f, 0.f, -0.f, 0.f, -0.f, -0.f,
+			CGLTF_SHUFFLE_PS(q2, 0, 1, 0), CGLTF_SHUFFLE_PS(q, 2, 2, 0), CGLTF_SHUFFLE_PS(q2, 1, 0, 1), CGLTF_SHUFFLE_PS(q, 3, 3, 1)));
+		_mm_storeu_ps(lm + 12, _mm_setr_ps(node->translation[0], node->translation[1], node->translation[2], 1.f));
+#else
+		const float32x4_t q = vld1q_f32(node->rotation);
+		const float32x4_t q2 = vaddq_f32(q, q);
+		const float scale_lanes[4] = { node->scale[0], node->scale[1], node->scale[2], 0.f };
+		const float32x4_t scale = vld1q_f32(scale_lanes);
+		const uint32_t mask_lanes[4] = { ~0u, ~0u, ~0u, 0u };
+		const uint32x4_t mask = vld1q_u32(mask_lanes);
+
+		static const float trs_rows[3][3][4] = {
+			{ { 1.f, -0.f, -0.f, 0.f }, { -0.f, 0.f, 0.f, 0.f }, { -0.f, 0.f, -0.f, 0.f } },
+			{ { -0.f, 1.f, -0.f, 0.f }, { 0.f, -0.f, 0.f, 0.f }, { -0.f, -0.f, 0.f, 0.f } },
+			{ { -0.f, -0.f, 1.f, 0.f }, { 0.f, 0.f, -0.f, 0.f }, { 0.f, -0.f, -0.f, 0.f } },
+		};
+
+#define CGLTF_TRS_ROW(row, a, b, c, d) \
+	vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vmulq_f32(vaddq_f32(vaddq_f32(vld1q_f32(trs_rows[row][0]), \
+		vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vmulq_f32(a, b)), vreinterpretq_u32_f32(vld1q_f32(trs_rows[row][1])))))), \
+		vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vmulq_f32(c, d)), vreinterpretq_u32_f32(vld1q_f32(trs_rows[row][2]))))), scale)), mask))
+
+		vst1q_f32(lm + 0, CGLTF_TRS_ROW(0, CGLTF_SHUFFLE_PS(q2, 1, 0, 0), CGLTF_SHUFFLE_PS(q, 1, 1, 2), CGLTF_SHUFFLE_PS(q2, 2, 2, 1), CGLTF_SHUFFLE_PS(q, 2, 3, 3)));
+		vst1q_f32(lm + 4, CGLTF_TRS_ROW(1, CGLTF_SHUFFLE_PS(q2, 0, 0, 1), CGLTF_SHUFFLE_PS(q, 1, 0, 2), CGLTF_SHUFFLE_PS(q2, 2, 2, 0), CGLTF_SHUFFLE_PS(q, 3, 2, 3)));
+		vst1q_f32(lm + 8, CGLTF_TRS_ROW(2, CGLTF_SHUFFLE_PS(q2, 0, 1, 0), CGLTF_SHUFFLE_PS(q, 2, 2, 0), CGLTF_SHUFFLE_PS(q2, 1, 0, 1), CGLTF_SHUFFLE_PS(q, 3, 3, 1)));
+
+		lm[12] = node->translation[0];
+		lm[13] = node->translation[1];
+		lm[14] = node->translation[2];
+		lm[15] = 1.f;
+#endif
+
+#undef CGLTF_TRS_ROW
+#else
+		float tx = node->translation[0];
+		float ty = node->translation[1];
+		float tz = node->translation[2];
+
+		float qx = node->rotation[0];
+		float qy = node->rotation[1];
+		float qz = node->rotation[2];
+		float qw = node->rotation[3];
+
+		float sx = node->scale[0];
+		float sy = node->scale[1];
+		float sz = node->scale[2];
+
+		lm[0] = (1 - 2 * qy*qy - 2 * qz*qz) * sx;
+		lm[1] = (2 * qx*qy + 2 * qz*qw) * sy;
+		lm[2] = (2 * qx*qz - 2 * qy*qw) * sz;
+		lm[3] = 0.f;
+
+		lm[4] = (2 * qx*qy - 2 * qz*qw) * sx;
+		lm[5] = (1 - 2 * qx*qx - 2 * qz*qz) * sy;
+		lm[6] = (2 * qy*qz + 2 * qx*qw) * sz;
+		lm[7] = 0.f;
+
+		lm[8] = (2 * qx*qz + 2 * qy*qw) * sx;
+		lm[9] = (2 * qy*qz - 2 * qx*qw) * sy;
+		lm[10] = (1 - 2 * qx*qx - 2 * qy*qy) * sz;
+		lm[11] = 0.f;
+
+		lm[12] = tx;
+		lm[13] = ty;
+		lm[14] = tz;
+		lm[15] = 1.f;
+#endif
+	}
+}
+
+static void cgltf_transform_multiply(cgltf_float* lm, const cgltf_float* pm)
+{
+#if defined(CGLTF_SSE2)
+	/* the last column of lm is kept as is, like in the scalar code */
+	const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+	const __m128 p0 = _mm_loadu_ps(pm + 0);
+	const __m128 p1 = _mm_loadu_ps(pm + 4);
+	const __m128 p2 = _mm_loadu_ps(pm + 8);
+	const __m128 p3 = _mm_loadu_ps(pm + 12);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		__m128 l = _mm_loadu_ps(lm + i * 4);
+		__m128 r = _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(CGLTF_SHUFFLE_PS(l, 0, 0, 0), p0),
+			_mm_mul_ps(CGLTF_SHUFFLE_PS(l, 1, 1, 1), p1)),
+			_mm_mul_ps(CGLTF_SHUFFLE_PS(l, 2, 2, 2), p2));
+
+		if (i == 3)
+		{
+			r = _mm_add_ps(r, p3);
+		}
+
+		_mm_storeu_ps(lm + i * 4, _mm_or_ps(_mm_and_ps(mask, r), _mm_andnot_ps(mask, l)));
+	}
+#elif defined(CGLTF_NEON)
+	/* the last column of lm is kept as is, like in the scalar code */
+	const uint32_t mask_lanes[4] = { ~0u, ~0u, ~0u, 0u };
+	const uint32x4_t mask = vld1q_u32(mask_lanes);
+	const float32x4_t p0 = vld1q_f32(pm + 0);
+	const float32x4_t p1 = vld1q_f32(pm + 4);
+	const float32x4_t p2 = vld1q_f32(pm + 8);
+	const float32x4_t p3 = vld1q_f32(pm + 12);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		float32x4_t l = vld1q_f32(lm + i * 4);
+		float32x4_t r = vaddq_f32(vaddq_f32(vmulq_laneq_f32(p0, l, 0), vmulq_laneq_f32(p1, l, 1)), vmulq_laneq_f32(p2, l, 2));
+
+		if (i == 3)
+		{
+			r = vaddq_f32(r, p3);
+		}
+
+		vst1q_f32(lm + i * 4, vbslq_f32(mask, r, l));
+	}
+#else
+	for (int i = 0; i < 4; ++i)
+	{
+		float l0 = lm[i * 4 + 0];
+		float l1 = lm[i * 4 + 1];
+		float l2 = lm[i * 4 + 2];
+
+		float r0 = l0 * pm[0] + l1 * pm[4] + l2 * pm[8];
+		float r1 = l0 * pm[1] + l1 * pm[5] + l2 * pm[9];
+		float r2 = l0 * pm[2] + l1 * pm[6] + l2 * pm[10];
+
+		lm[i * 4 + 0] = r0;
+		lm[i * 4 + 1] = r1;
+		lm[i * 4 + 2] = r2;
+	}
+
+	lm[12] += pm[12];
+	lm[13] += pm[13];
+	lm[14] += pm[14];
+#endif
+}
+
+void cgltf_node_transform_world(const cgltf_node* node, cgltf_float* out_matrix)
+{
+	cgltf_float* lm = out_matrix;
+	cgltf_node_transform_local(node, lm);
+
+	const cgltf_node* parent = node->parent;
+
+	while (parent)
+	{
+		float pm[16];
+		cgltf_node_transform_local(parent, pm);
+
+		cgltf_transform_multiply(lm, pm);
+
+		parent = parent->parent;
+	}
+}
+
+static cgltf_size cgltf_node_transforms_world(const cgltf_node* node, const cgltf_float* parent_matrix, cgltf_float* out_matrices, cgltf_size offset)
+{
+	cgltf_float* lm = out_matrices ? out_matrices + offset * 16 : NULL;
+
+	if (lm)
+	{
+		cgltf_node_transform_local(node, lm);
+
+		if (parent_matrix)
+		{
+			cgltf_transform_multiply(lm, parent_matrix);
+		}
+	}
+
+	cgltf_size count = 1;
+
+	for (cgltf_size i = 0; i < node->children_count; ++i)
+	{
+		count += cgltf_node_transforms_world(node->children[i], lm, out_matrices, offset + count);
+	}
+
+	return count;
+}
+
+cgltf_size cgltf_scene_transforms_world(const cgltf_scene* scene, cgltf_float* out_matrices)
+{
+	cgltf_size count = 0;
+
+	for (cgltf_size i = 0; i < scene->nodes_count; ++i)
+	{
+		count += cgltf_node_transforms_world(scene->nodes[i], NULL, out_matrices, count);
+	}
+
+	return count;
+}
+
+static cgltf_size cgltf_component_read_index(const void* in, cgltf_component_type component_type)
+{
+	switch (component_type)
+	{
+		case cgltf_component_type_r_16:
+			return *((const int16_t*) in);
+		case cgltf_component_type_r_16u:
+			return *((const uint16_t*) in);
+		case cgltf_component_type_r_32u:
+			return *((const uint32_t*) in);
+		case cgltf_component_type_r_32f:
+			return (cgltf_size)*((const float*) in);
+		case cgltf_component_type_r_8:
+			return *((const int8_t*) in);
+		case cgltf_component_type_r_8u:
+		case cgltf_component_type_invalid:
+		default:
+			return *((const uint8_t*) in);
+	}
+}
+
+static cgltf_float cgltf_component_read_float(const void* in, cgltf_component_type component_type, cgltf_bool normalized)
+{
+	if (component_type == cgltf_component_type_r_32f)
+	{
+		return *((const float*) in);
+	}
+
+	if (normalized)
+	{
+		switch (component_type)
+		{
+			case cgltf_component_type_r_32u:
+				return *((const uint32_t*) in) / (float) UINT_MAX;
+			case cgltf_component_type_r_16:
+				return *((const int16_t*) in) / (float) SHRT_MAX;
+			case cgltf_component_type_r_16u:
+				return *((const uint16_t*) in) / (float) USHRT_MAX;
+			case cgltf_component_type_r_8:
+				return *((const int8_t*) in) / (float) SCHAR_MAX;
+			case cgltf_component_type_r_8u:
+			case cgltf_component_type_invalid:
+			default:
+				return *((const uint8_t*) in) / (float) UCHAR_MAX;
+		}
+	}
+
+	// Signed components must not go through cgltf_size, which would wrap negative values
+	switch (component_type)
+	{
+		case cgltf_component_type_r_16:
+			return *((const int16_t*) in);
+		case cgltf_component_type_r_8:
+			return *((const int8_t*) in);
+		default:
+			return (cgltf_float)cgltf_component_read_index(in, component_type);
+	}
+}
+
+static cgltf_size cgltf_num_components(cgltf_type type);
+static cgltf_size cgltf_component_size(cgltf_component_type component_type);
+
+static cgltf_bool cgltf_element_read_float(const uint8_t* element, cgltf_type type, cgltf_component_type component_type, cgltf_bool normalized, cgltf_float* out, cgltf_size element_size)
+{
+	cgltf_size num_components = cgltf_num_components(type);
+
+	if (element_size < num_components) {
+		return 0;
+	}
+
+	// There are three special cases for component extraction, see #data-alignment in the 2.0 spec.
+
+	cgltf_size component_size = cgltf_component_size(component_type);
+
+	if (type == cgltf_type_mat2 && component_size == 1)
+	{
+		out[0] = cgltf_component_read_float(element, component_type, normalized);
+		out[1] = cgltf_component_read_float(element + 1, component_type, normalized);
+		out[2] = cgltf_component_read_float(element + 4, component_type, normalized);
+		out[3] = cgltf_component_read_float(element + 5, component_type, normalized);
+		return 1;
+	}
+
+	if (type == cgltf_type_mat3 && component_size == 1)
+	{
+		out[0] = cgltf_component_read_float(element, component_type, normalized);
+		out[1] = cgltf_component_read_float(element + 1, component_type, normalized);
+		out[2] = cgltf_component_read_float(element + 2, component_type, normalized);
+		out[3] = cgltf_component_read_float(element + 4, component_type, normalized);
+		out[4] = cgltf_component_read_float(element + 5, component_type, normalized);
+		out[5] = cgltf_component_read_float(element + 6, component_type, normalized);
+		out[6] = cgltf_component_read_float(element + 8, component_type, normalized);
+		out[7] = cgltf_component_read_float(element + 9, component_type, normalized);
+		out[8] = cgltf_component_read_float(element + 10, component_type, normalized);
+		return 1;
+	}
+
+	if (type == cgltf_type_mat3 && component_size == 2)
+	{
+		out[0] = cgltf_component_read_float(element, component_type, normalized);
+		out[1] = cgltf_component_read_float(element + 2, component_type, normalized);
+		out[2] = cgltf_component_read_float(element + 4, component_type, normalized);
+		out[3] = cgltf_component_read_float(element + 8, component_type, normalized);
+		out[4] = cgltf_component_read_float(element + 10, component_type, normalized);
+		out[5] = cgltf_component_read_float(element + 12, component_type, normalized);
+		out[6] = cgltf_component_read_float(element + 16, component_type, normalized);
+		out[7] = cgltf_component_read_float(element + 18, component_type, normalized);
+		out[8] = cgltf_component_read_float(element + 20, component_type, normalized);
+		return 1;
+	}
+
+	for (cgltf_size i = 0; i < num_components; ++i)
+	{
+		out[i] = cgltf_component_read_float(element + component_size * i, component_type, normalized);
+	}
+	return 1;
+}
+
+
+static cgltf_size cgltf_sparse_lower_bound(const cgltf_accessor_sparse* sparse, const uint8_t* indices, cgltf_size index)
+{
+	cgltf_size index_size = cgltf_component_size(sparse->indices_component_type);
+	cgltf_size begin = 0;
+	cgltf_size end = sparse->count;
+
+	// Sparse indices are strictly increasing, see #sparse-accessors in the 2.0 spec
+	while (begin < end)
+	{
+		cgltf_size middle = begin + (end - begin) / 2;
+
+		if (cgltf_component_read_index(indices + index_size * middle, sparse->indices_component_type) < index)
+		{
+			begin = middle + 1;
+		}
+		else
+		{
+			end = middle;
+		}
+	}
+
+	return begin;
+}
+
+// Sets *out_value to the sparse value of the element, or NULL if it has none; returns 0 if the sparse data is not available
+static cgltf_bool cgltf_find_sparse_value(const cgltf_accessor* accessor, cgltf_size index, const uint8_t** out_value)
+{
+	const cgltf_accessor_sparse* sparse = &accessor->sparse;
+
+	const uint8_t* indices = cgltf_buffer_view_bytes(sparse->indices_buffer_view);
+	const uint8_t* values = cgltf_buffer_view_bytes(sparse->values_buffer_view);
+
+	*out_value = NULL;
+
+	if (!indices || !values)
+	{
+		return 0;
+	}
+
+	indices += sparse->indices_byte_offset;
+
+	cgltf_size position = cgltf_sparse_lower_bound(sparse, indices, index);
+	cgltf_size index_size = cgltf_component_size(sparse->indices_component_type);
+
+	if (position < sparse->count && cgltf_component_read_index(indices + index_size * position, sparse->indices_component_type) == index)
+	{
+		values += sparse->values_byte_offset;
+		*out_value = values + cgltf_calc_size(accessor->type, accessor->component_type) * position;
+	}
+
+	return 1;
+}
+
+// Sets *out_element to the element, or NULL if it is zero because a sparse accessor without a buffer view has no
+// value for it; returns 0 if the data of a buffer view the element depends on is not available
+static cgltf_bool cgltf_find_element(const cgltf_accessor* accessor, cgltf_size index, const uint8_t** out_element)
+{
+	*out_element = NULL;
+
+	if (accessor->sparse_data)
+	{
+		*out_element = (const uint8_t*) accessor->sparse_data + cgltf_calc_size(accessor->type, accessor->component_type) * index;
+		return 1;
+	}
+
+	if (accessor->is_sparse)
+	{
+		if (!cgltf_find_sparse_value(accessor, index, out_element))
+		{
+			return 0;
+		}
+
+		if (*out_element)
+		{
+			return 1;
+		}
+	}
+
+	if (accessor->buffer_view)
+	{
+		const uint8_t* element = cgltf_buffer_view_bytes(accessor->buffer_view);
+
+		if (!element)
+		{
+			return 0;
+		}
+
+		*out_element = element + accessor->offset + accessor->stride * index;
+	}
+
+	return 1;
+}
+
+cgltf_bool cgltf_accessor_read_float(const cgltf_accessor* accessor, cgltf_size index, cgltf_float* out, cgltf_size element_size)
+{
+	if (!accessor->is_sparse && accessor->buffer_view == NULL)
+	{
+		return 0;
+	}
+
+	const uint8_t* element = NULL;
+
+	if (!cgltf_find_element(accessor, index, &element))
+	{
+		return 0;
+	}
+
+	if (!element)
+	{
+		// Elements of sparse accessors without a buffer view that have no sparse value are zero
+		cgltf_size num_components = cgltf_num_components(accessor->type);
+
+		if (element_size < num_components)
+		{
+			return 0;
+		}
+
+		for (cgltf_size i = 0; i < num_components; ++i)
+		{
+			out[i] = 0;
+		}
+
+		return 1;
+	}
+
+	return cgltf_element_read_float(element, accessor->type, accessor->component_type, accessor->normalized, out, element_size);
+}
+
+cgltf_size cgltf_accessor_read_index(const cgltf_accessor* accessor, cgltf_size index)
+{
+	const uint8_t* element = NULL;
+
+	if (cgltf_find_element(accessor, index, &element) && element)
+	{
+		return cgltf_component_read_index(element, accessor->component_type);
+	}
+
+	return 0;
+}
+
+static cgltf_result cgltf_densify_sparse(const cgltf_options* options, cgltf_accessor* accessor)
+{
+	const cgltf_accessor_sparse* sparse = &accessor->sparse;
+
+	const cgltf_buffer_view* base_view = accessor->buffer_view;
+	const cgltf_buffer_view* indices_view = sparse->indices_buffer_view;
+	const cgltf_buffer_view* values_view = sparse->values_buffer_view;
+
+	const uint8_t* base_data = base_view ? cgltf_buffer_view_bytes(base_view) : NULL;
+	const uint8_t* indices_data = cgltf_buffer_view_bytes(indices_view);
+	const uint8_t* values_data = cgltf_buffer_view_bytes(values_view);
+
+	if (accessor->count == 0 || !indices_data || !values_data || (base_view && !base_data))
+	{
+		return cgltf_result_success;
+	}
+
+	if (sparse->indices_component_type != cgltf_component_type_r_8u &&
+		sparse->indices_component_type != cgltf_component_type_r_16u &&
+		sparse->indices_component_type != cgltf_component_type_r_32u)
+	{
+		return cgltf_result_invalid_gltf;
+	}
+
+	cgltf_size element_size = cgltf_calc_size(accessor->type, accessor->component_type);
+	cgltf_size index_size = cgltf_component_size(sparse->indices_component_type);
+
+	if (indices_view->offset + indices_view->size > indices_view->buffer->size ||
+		values_view->offset + values_view->size > values_view->buffer->size ||
+		sparse->indices_byte_offset + index_size * sparse->count > indices_view->size ||
+		sparse->values_byte_offset + element_size * sparse->count > values_view->size)
+	{
+		return cgltf_result_data_too_short;
+	}
+
+	if (base_view &&
+		(base_view->offset + base_view->size > base_view->buffer->size ||
+		accessor->offset + accessor->stride * (accessor->count - 1) + element_size > base_view->size))
+	{
+		return cgltf_result_data_too_short;
+	}
+
+	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
+
+	uint8_t* dense = (uint8_t*)memory_alloc(options->memory_user_data, element_size * accessor->count);
+	if (!dense)
+	{
+		return cgltf_result_out_of_memory;
+	}
+
+	if (base_view)
+	{
+		const uint8_t* element = base_data + accessor->offset;
+
+		for (cgltf_size i = 0; i < accessor->count; ++i)
+		{
+			memcpy(dense + element_size * i, element + accessor->stride * i, element_size);
+		}
+	}
+	else
+	{
+		memset(dense, 0, element_size * accessor->count);
+	}
+
+	const uint8_t* indices = indices_data + sparse->indices_byte_offset;
+	const uint8_t* values = values_data + sparse->values_byte_offset;
+
+	for (cgltf_size i = 0; i < sparse->count; ++i)
+	{
+		cgltf_size index = cgltf_component_read_index(indices + index_size * i, sparse->indices_component_type);
+
+		if (index < accessor->count)
+		{
+			memcpy(dense + element_size * index, values + element_size * i, element_size);
+		}
+	}
+
+	accessor->sparse_data = dense;
+	return cgltf_result_success;
+}
+
+#if defined(CGLTF_SSE2)
+static __m128 cgltf_load4_r_8u(const uint8_t* in)
+{
+	int32_t v;
+	memcpy(&v, in, 4);
+	__m128i zero = _mm_setzero_si128();
+	__m128i x = _mm_unpacklo_epi8(_mm_cvtsi32_si128(v), zero);
+	return _mm_cvtepi32_ps(_mm_unpacklo_epi16(x, zero));
+}
+
+static __m128 cgltf_load4_r_8(const uint8_t* in)
+{
+	int32_t v;
+	memcpy(&v, in, 4);
+	__m128i x = _mm_cvtsi32_si128(v);
+	x = _mm_unpacklo_epi8(x, x);
+	x = _mm_unpacklo_epi16(x, x);
+	return _mm_cvtepi32_ps(_mm_srai_epi32(x, 24));
+}
+
+static __m128 cgltf_load4_r_16u(const uint8_t* in)
+{
+	__m128i x = _mm_loadl_epi64((const __m128i*)in);
+	return _mm_cvtepi32_ps(_mm_unpacklo_epi16(x, _mm_setzero_si128()));
+}
+
+static __m128 cgltf_load4_r_16(const uint8_t* in)
+{
+	__m128i x = _mm_loadl_epi64((const __m128i*)in);
+	return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+}
+
+#define CGLTF_VEC4 __m128
+#define CGLTF_VEC4_SET1(v) _mm_set1_ps(v)
+#define CGLTF_VEC4_DIV(a, b) _mm_div_ps(a, b)
+#define CGLTF_VEC4_STORE(p, v) _mm_storeu_ps(p, v)
+#elif defined(CGLTF_NEON)
+static float32x4_t cgltf_load4_r_8u(const uint8_t* in)
+{
+	uint32_t v;
+	memcpy(&v, in, 4);
+	uint16x8_t x = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(v)));
+	return vcvtq_f32_u32(vmovl_u16(vget_low_u16(x)));
+}
+
+static float32x4_t cgltf_load4_r_8(const uint8_t* in)
+{
+	uint32_t v;
+	memcpy(&v, in, 4);
+	int16x8_t x = vmovl_s8(vreinterpret_s8_u32(vdup_n_u32(v)));
+	return vcvtq_f32_s32(vmovl_s16(vget_low_s16(x)));
+}
+
+static float32x4_t cgltf_load4_r_16u(const uint8_t* in)
+{
+	return vcvtq_f32_u32(vmovl_u16(vld1_u16((const uint16_t*)in)));
+}
+
+static float32x4_t cgltf_load4_r_16(const uint8_t* in)
+{
+	return vcvtq_f32_s32(vmovl_s16(vld1_s16((const int16_t*)in)));
+}
+
+#define CGLTF_VEC4 float32x4_t
+#define CGLTF_VEC4_SET1(v) vdupq_n_f32(v)
+#define CGLTF_VEC4_DIV(a, b) vdivq_f32(a, b)
+#define CGLTF_VEC4_STORE(p, v) vst1q_f32(p, v)
+#endif
+
+#if defined(CGLTF_AVX2)
+#define CGLTF_DEQUANTIZE_LOOP_AVX2(convert_, component_size_) \
+	for (; i + 8 <= total; i += 8) \
+	{ \
+		__m256 f = _mm256_cvtepi32_ps(convert_); \
+		_mm256_storeu_ps(out + i, divide ? _mm256_div_ps(f, d8) : f); \
+	}
+#endif
+
+#if defined(CGLTF_VEC4)
+#define CGLTF_DEQUANTIZE_LOOP(load_, component_size_) \
+	for (; i + 4 <= total; i += 4) \
+	{ \
+		CGLTF_VEC4 f = load_(element + i * (component_size_)); \
+		CGLTF_VEC4_STORE(out + i, divide ? CGLTF_VEC4_DIV(f, d) : f); \
+	}
+
+/* Vec3 elements padded to 4 components convert all 4 and let the next element overwrite the padding.
+ * The last element is left to the scalar code so that neither input nor output is overrun. */
+#define CGLTF_DEQUANTIZE_PADDED3_LOOP(load_) \
+	for (; i + 1 < count; ++i) \
+	{ \
+		CGLTF_VEC4 f = load_(element + stride * i); \
+		CGLTF_VEC4_STORE(out + i * 3, divide ? CGLTF_VEC4_DIV(f, d) : f); \
+	}
+#endif
+
+/* Converts 8- and 16-bit elements with vector instructions where the layout allows it. Division is
+ * skipped for a divisor of 1, which is exact, so results match the scalar code bit for bit. Returns
+ * the number of leading elements that were converted. */
+static cgltf_size cgltf_dequantize_simd(const uint8_t* element, cgltf_size stride, cgltf_size count, cgltf_size num_components, cgltf_component_type component_type, float divisor, cgltf_float* out)
+{
+#if defined(CGLTF_VEC4)
+	cgltf_size component_size = cgltf_component_size(component_type);
+	cgltf_size total = count * num_components;
+	cgltf_size i = 0;
+	int divide = divisor != 1.0f;
+	CGLTF_VEC4 d = CGLTF_VEC4_SET1(divisor);
+
+	if (stride == component_size * num_components)
+	{
+#if defined(CGLTF_AVX2)
+		__m256 d8 = _mm256_set1_ps(divisor);
+
+		switch (component_type)
+		{
+		case cgltf_component_type_r_8u:
+			CGLTF_DEQUANTIZE_LOOP_AVX2(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(element + i))), 1)
+			break;
+		case cgltf_component_type_r_8:
+			CGLTF_DEQUANTIZE_LOOP_AVX2(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)(element + i))), 1)
+			break;
+		case cgltf_component_type_r_16u:
+			CGLTF_DEQUANTIZE_LOOP_AVX2(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(element + i * 2))), 2)
+			break;
+		case cgltf_component_type_r_16:
+			CGLTF_DEQUANTIZE_LOOP_AVX2(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(element + i * 2))), 2)
+			break;
+		default:
+			return 0;
+		}
+#endif
+
+		switch (component_type)
+		{
+		case cgltf_component_type_r_8u:
+			CGLTF_DEQUANTIZE_LOOP(cgltf_load4_r_8u, 1)
+			break;
+		case cgltf_component_type_r_8:
+			CGLTF_DEQUANTIZE_LOOP(cgltf_load4_r_8, 1)
+			break;
+		case cgltf_component_type_r_16u:
+			CGLTF_DEQUANTIZE_LOOP(cgltf_load4_r_16u, 2)
+			break;
+		case cgltf_component_type_r_16:
+			CGLTF_DEQUANTIZE_LOOP(cgltf_load4_r_16, 2)
+			break;
+		default:
+			return 0;
+		}
+
+		return i / num_components;
+	}
+
+	if (num_components == 3 && stride == component_size * 4)
+	{
+		switch (component_type)
+		{
+		case cgltf_component_type_r_8u:
+			CGLTF_DEQUANTIZE_PADDED3_LOOP(cgltf_load4_r_8u)
+			break;
+		case cgltf_component_type_r_8:
+			CGLTF_DEQUANTIZE_PADDED3_LOOP(cgltf_load4_r_8)
+			break;
+		case cgltf_component_type_r_16u:
+			CGLTF_DEQUANTIZE_PADDED3_LOOP(cgltf_load4_r_16u)
+			break;
+		case cgltf_component_type_r_16:
+			CGLTF_DEQUANTIZE_PADDED3_LOOP(cgltf_load4_r_16)
+			break;
+		default:
+			return 0;
+		}
+
+		return i;
+	}
+#else
+	(void)element;
+	(void)stride;
+	(void)count;
+	(void)num_components;
+	(void)component_type;
+	(void)divisor;
+	(void)out;
+#endif
+
+	return 0;
+}
+
+#undef CGLTF_DEQUANTIZE_LOOP_AVX2
+#undef CGLTF_DEQUANTIZE_LOOP
+#undef CGLTF_DEQUANTIZE_PADDED3_LOOP
+
+/* Converts `count` elements of `components` each, starting at element `first_`; the divisor is 1 for
+ * unnormalized data, which keeps results identical to cgltf_component_read_float. */
+#define CGLTF_UNPACK_LOOP(ctype_, divisor_, components_) \
+	for (cgltf_size i = first_; i < count; ++i) \
+	{ \
+		const ctype_* in = (const ctype_*)(element + stride * i); \
+		for (cgltf_size k = 0; k < (components_); ++k) \
+		{ \
+			out[i * (components_) + k] = (cgltf_float)in[k] / (divisor_); \
+		} \
+	}
+
+#define CGLTF_UNPACK_COMPONENTS(ctype_, divisor_) \
+	first_ = cgltf_dequantize_simd(element, stride, count, num_components, component_type, divisor_, out); \
+	switch (num_components) \
+	{ \
+	case 1: CGLTF_UNPACK_LOOP(ctype_, divisor_, 1) break; \
+	case 2: CGLTF_UNPACK_LOOP(ctype_, divisor_, 2) break; \
+	case 3: CGLTF_UNPACK_LOOP(ctype_, divisor_, 3) break; \
+	case 4: CGLTF_UNPACK_LOOP(ctype_, divisor_, 4) break; \
+	default: CGLTF_UNPACK_LOOP(ctype_, divisor_, num_components) break; \
+	}
+
+static void cgltf_unpack_floats(const uint8_t* element, cgltf_size stride, cgltf_size count, cgltf_size num_components, cgltf_component_type component_type, cgltf_bool normalized, cgltf_float* out)
+{
+	cgltf_size first_ = 0;
+
+	switch (component_type)
+	{
+	case cgltf_component_type_r_32f:
+		if (stride == sizeof(cgltf_float) * num_components)
+		{
+			memcpy(out, element, sizeof(cgltf_float) * num_components * count);
+		}
+		else
+		{
+			for (cgltf_size i = 0; i < count; ++i)
+			{
+				memcpy(out + i * num_components, element + stride * i, sizeof(cgltf_float) * num_components);
+			}
+		}
+		break;
+
+	case cgltf_component_type_r_32u:
+		switch (num_components)
+		{
+		case 1: CGLTF_UNPACK_LOOP(uint32_t, normalized ? (float) UINT_MAX : 1.0f, 1) break;
+		default: CGLTF_UNPACK_LOOP(uint32_t, normalized ? (float) UINT_MAX : 1.0f, num_components) break;
+		}
+		break;
+
+	case cgltf_component_type_r_16:
+		CGLTF_UNPACK_COMPONENTS(int16_t, normalized ? (float) SHRT_MAX : 1.0f)
+		break;
+
+	case cgltf_component_type_r_16u:
+		CGLTF_UNPACK_COMPONENTS(uint16_t, normalized ? (float) USHRT_MAX : 1.0f)
+		break;
+
+	case cgltf_component_type_r_8:
+		CGLTF_UNPACK_COMPONENTS(int8_t, normalized ? (float) SCHAR_MAX : 1.0f)
+		break;
+
+	case cgltf_component_type_r_8u:
+	case cgltf_component_type_invalid:
+	default:
+		CGLTF_UNPACK_COMPONENTS(uint8_t, normalized ? (float) UCHAR_MAX : 1.0f)
+		break;
+	}
+}
+
+#undef CGLTF_UNPACK_COMPONENTS
+#undef CGLTF_UNPACK_LOOP
+
+static void cgltf_unpack_elements(const cgltf_accessor* accessor, const uint8_t* element, cgltf_size stride, cgltf_size count, cgltf_float* out)
+{
+	cgltf_size num_components = cgltf_num_components(accessor->type);
+	cgltf_size component_size = cgltf_component_size(accessor->component_type);
+
+	// Matrices with padded columns (see #data-alignment in the 2.0 spec) are rare enough to use the per-element path
+	if ((accessor->type == cgltf_type_mat2 && component_size == 1) ||
+		(accessor->type == cgltf_type_mat3 && (component_size == 1 || component_size == 2)))
+	{
+		for (cgltf_size i = 0; i < count; ++i)
+		{
+			cgltf_element_read_float(element + stride * i, accessor->type, accessor->component_type, accessor->normalized, out + i * num_components, num_components);
+		}
+	}
+	else
+	{
+		cgltf_unpack_floats(element, stride, count, num_components, accessor->component_type, accessor->normalized, out);
+	}
+}
+
+static void cgltf_unpack_sparse_values(const cgltf_accessor* accessor, cgltf_size first, cgltf_size count, cgltf_float* out)
+{
+	const cgltf_accessor_sparse* sparse = &accessor->sparse;
+
+	const uint8_t* indices = cgltf_buffer_view_bytes(sparse->indices_buffer_view) + sparse->indices_byte_offset;
+	const uint8_t* values = cgltf_buffer_view_bytes(sparse->values_buffer_view) + sparse->values_byte_offset;
+
+	cgltf_size num_components = cgltf_num_components(accessor->type);
+	cgltf_size element_size = cgltf_calc_size(accessor->type, accessor->component_type);
+	cgltf_size index_size = cgltf_component_size(sparse->indices_component_type);
+
+	for (cgltf_size i = cgltf_sparse_lower_bound(sparse, indices, first); i < sparse->count; ++i)
+	{
+		cgltf_size index = cgltf_component_read_index(indices + index_size * i, sparse->indices_component_type);
+
+		if (index >= first + count)
+		{
+			break;
+		}
+
+		cgltf_element_read_float(values + element_size * i, accessor->type, accessor->component_type, accessor->normalized, out + (index - first) * num_components, num_components);
+	}
+}
+
+cgltf_size cgltf_accessor_unpack_floats_range(const cgltf_accessor* accessor, cgltf_size first, cgltf_size count, cgltf_float* out, cgltf_size float_count)
+{
+	if ((!accessor->is_sparse && accessor->buffer_view == NULL) || first >= accessor->count)
+	{
+		return 0;
+	}
+
+	cgltf_size num_components = cgltf_num_components(accessor->type);
+
+	if (count > accessor->count - first)
+	{
+		count = accessor->count - first;
+	}
+
+	if (!out)
+	{
+		return count * num_components;
+	}
+
+	if (count > float_count / num_components)
+	{
+		count = float_count / num_components;
+	}
+
+	if (accessor->sparse_data)
+	{
+		cgltf_size element_size = cgltf_calc_size(accessor->type, accessor->component_type);
+		cgltf_unpack_elements(accessor, (const uint8_t*) accessor->sparse_data + element_size * first, element_size, count, out);
+		return count * num_components;
+	}
+
+	if (accessor->is_sparse && (!cgltf_buffer_view_bytes(accessor->sparse.indices_buffer_view) || !cgltf_buffer_view_bytes(accessor->sparse.values_buffer_view)))
+	{
+		return 0;
+	}
+
+	if (accessor->buffer_view)
+	{
+		const uint8_t* element = cgltf_buffer_view_bytes(accessor->buffer_view);
+		if (!element)
+		{
+			return 0;
+		}
+
+		element += accessor->offset + accessor->stride * first;
+		cgltf_unpack_elements(accessor, element, accessor->stride, count, out);
+	}
+	else
+	{
+		memset(out, 0, count * num_components * sizeof(cgltf_float));
+	}
+
+	if (accessor->is_sparse)
+	{
+		cgltf_unpack_sparse_values(accessor, first, count, out);
+	}
+
+	return count * num_components;
+}
+
+cgltf_size cgltf_accessor_unpack_floats(const cgltf_accessor* accessor, cgltf_float* out, cgltf_size float_count)
+{
+	return cgltf_accessor_unpack_floats_range(accessor, 0, accessor->count, out, float_count);
+}
+
+static void cgltf_store_index(void* out, cgltf_size out_component_size, cgltf_size i, cgltf_size index)
+{
+	switch (out_component_size)
+	{
+	case 1:
+		((uint8_t*)out)[i] = (uint8_t)index;
+		break;
+	case 2:
+		((uint16_t*)out)[i] = (uint16_t)index;
+		break;
+	default:
+		((uint32_t*)out)[i] = (uint32_t)index;
+		break;
+	}
+}
+
+static void cgltf_unpack_indices(const uint8_t* in, cgltf_size stride, cgltf_component_type component_type, void* out, cgltf_size out_component_size, cgltf_size count)
+{
+	cgltf_size component_size = cgltf_component_size(component_type);
+	cgltf_size i = 0;
+
+	if (stride == component_size)
+	{
+		if (component_size == out_component_size)
+		{
+			memcpy(out, in, count * component_size);
+			return;
+		}
+
+#if defined(CGLTF_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+
+		if (component_size == 1 && out_component_size == 2)
+		{
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+				_mm_storeu_si128((__m128i*)((uint16_t*)out + i), _mm_unpacklo_epi8(v, zero));
+				_mm_storeu_si128((__m128i*)((uint16_t*)out + i + 8), _mm_unpackhi_epi8(v, zero));
+			}
+		}
+		else if (component_size == 1 && out_component_size == 4)
+		{
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+				__m128i lo = _mm_unpacklo_epi8(v, zero);
+				__m128i hi = _mm_unpackhi_epi8(v, zero);
+				_mm_storeu_si128((__m128i*)((uint32_t*)out + i), _mm_unpacklo_epi16(lo, zero));
+				_mm_storeu_si128((__m128i*)((uint32_t*)out + i + 4), _mm_unpackhi_epi16(lo, zero));
+				_mm_storeu_si128((__m128i*)((uint32_t*)out + i + 8), _mm_unpacklo_epi16(hi, zero));
+				_mm_storeu_si128((__m128i*)((uint32_t*)out + i + 12), _mm_unpackhi_epi16(hi, zero));
+			}
+		}
+		else if (component_size == 2 && out_component_size == 4)
+		{
+			for (; i + 8 <= count; i += 8)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)(in + i * 2));
+				_mm_storeu_si128((__m128i*)((uint32_t*)out + i), _mm_unpacklo_epi16(v, zero));
+				_mm_storeu_si128((__m128i*)((uint32_t*)out + i + 4), _mm_unpackhi_epi16(v, zero));
+			}
+		}
+#elif defined(CGLTF_NEON)
+		if (component_size == 1 && out_component_size == 2)
+		{
+			for (; i + 8 <= count; i += 8)
+			{
+				vst1q_u16((uint16_t*)out + i, vmovl_u8(vld1_u8(in + i)));
+			}
+		}
+		else if (component_size == 1 && out_component_size == 4)
+		{
+			for (; i + 8 <= count; i += 8)
+			{
+				uint16x8_t v = vmovl_u8(vld1_u8(in + i));
+				vst1q_u32((uint32_t*)out + i, vmovl_u16(vget_low_u16(v)));
+				vst1q_u32((uint32_t*)out + i + 4, vmovl_u16(vget_high_u16(v)));
+			}
+		}
+		else if (component_size == 2 && out_component_size == 4)
+		{
+			for (; i + 4 <= count; i += 4)
+			{
+				vst1q_u32((uint32_t*)out + i, vmovl_u16(vreinterpret_u16_u8(vld1_u8(in + i * 2))));
+			}
+		}
+#endif
 	}
-	else
+
+	for (; i < count; ++i)
 	{
-		strncpy(dest, data->json + extras->start_offset, json_size);
-		dest[json_size] = 0;
+		cgltf_store_index(out, out_component_size, i, cgltf_component_read_index(in + stride * i, component_type));
 	}
-
-	return cgltf_result_success;
 }
 
-void cgltf_free(cgltf_data* data)
+cgltf_size cgltf_accessor_unpack_indices(const cgltf_accessor* accessor, void* out, cgltf_size out_component_size, cgltf_size index_count)
 {
-	if (!data)
+	if (accessor->type != cgltf_type_scalar ||
+		(accessor->component_type != cgltf_component_type_r_8u &&
+		accessor->component_type != cgltf_component_type_r_16u &&
+		accessor->component_type != cgltf_component_type_r_32u))
 	{
-		return;
+		return 0;
 	}
 
-	data->memory_free(data->memory_user_data, data->asset.copyright);
-	data->memory_free(data->memory_user_data, data->asset.generator);
-	data->memory_free(data->memory_user_data, data->asset.version);
-	data->memory_free(data->memory_user_data, data->asset.min_version);
+	cgltf_size component_size = cgltf_component_size(accessor->component_type);
 
-	data->memory_free(data->memory_user_data, data->accessors);
-	data->memory_free(data->memory_user_data, data->buffer_views);
+	if ((out_component_size != 1 && out_component_size != 2 && out_component_size != 4) || out_component_size < component_size)
+	{
+		return 0;
+	}
 
-	for (cgltf_size i = 0; i < data->buffers_count; ++i)
+	if (!accessor->is_sparse && accessor->buffer_view == NULL)
+	{
+		return 0;
+	}
+
+	if (!out)
+	{
+		return accessor->count;
+	}
+
+	if (index_count > accessor->count)
+	{
+		index_count = accessor->count;
+	}
+
+	if (accessor->sparse_data)
+	{
+		cgltf_unpack_indices((const uint8_t*) accessor->sparse_data, component_size, accessor->component_type, out, out_component_size, index_count);
+	}
+	else if (accessor->is_sparse)
 	{
-		if (data->buffers[i].data != data->bin)
+		for (cgltf_size i = 0; i < index_count; ++i)
 		{
-			data->memory_free(data->memory_user_data, data->buffers[i].data);
+			cgltf_store_index(out, out_component_size, i, cgltf_accessor_read_index(accessor, i));
+		}
+	}
+	else
+	{
+		const uint8_t* element = cgltf_buffer_view_bytes(accessor->buffer_view);
+		if (!element)
+		{
+			return 0;
 		}
 
-		data->memory_free(data->memory_user_data, data->buffers[i].uri);
+		element += accessor->offset;
+		cgltf_unpack_indices(element, accessor->stride, accessor->component_type, out, out_component_size, index_count);
 	}
 
-	data->memory_free(data->memory_user_data, data->buffers);
+	return index_count;
+}
 
-	for (cgltf_size i = 0; i < data->meshes_count; ++i)
+static cgltf_size cgltf_animation_channel_components(const cgltf_animation_channel* channel)
+{
+	switch (channel->target_path)
 	{
-		data->memory_free(data->memory_user_data, data->meshes[i].name);
-
-		for (cgltf_size j = 0; j < data->meshes[i].primitives_count; ++j)
+	case cgltf_animation_path_type_translation:
+	case cgltf_animation_path_type_scale:
+		return 3;
+	case cgltf_animation_path_type_rotation:
+		return 4;
+	case cgltf_animation_path_type_weights:
+		if (channel->sampler && channel->sampler->input && channel->sampler->output && channel->sampler->input->count)
 		{
-			for (cgltf_size k = 0; k < data->meshes[i].primitives[j].attributes_count; ++k)
-			{
-				data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].attributes[k].name);
-			}
+			cgltf_size keys = channel->sampler->input->count * (channel->sampler->interpolation == cgltf_interpolation_type_cubic_spline ? 3 : 1);
+			return channel->sampler->output->count / keys;
+		}
+		return 0;
+	default:
+		return 0;
+	}
+}
 
-			data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].attributes);
+static cgltf_float cgltf_animation_key_time(const cgltf_accessor* input, cgltf_size key)
+{
+	cgltf_float time = 0.f;
+	cgltf_accessor_read_float(input, key, &time, 1);
+	return time;
+}
 
-			for (cgltf_size k = 0; k < data->meshes[i].primitives[j].targets_count; ++k)
-			{
-				for (cgltf_size m = 0; m < data->meshes[i].primitives[j].targets[k].attributes_count; ++m)
-				{
-					data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].targets[k].attributes[m].name);
-				}
+/* Returns the last key in [0, count - 2] whose time is not after the given time, which must not be before the first key */
+static cgltf_size cgltf_animation_find_key(const cgltf_accessor* input, cgltf_float time, cgltf_size* cursor)
+{
+	cgltf_size last = input->count - 2;
+	cgltf_size lo = 0;
 
-				data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].targets[k].attributes);
+	if (cursor && *cursor <= last && cgltf_animation_key_time(input, *cursor) <= time)
+	{
+		/* playback that moves forward usually stays on the same key or moves by a few keys */
+		lo = *cursor;
+
+		for (int step = 0; step < 4; ++step)
+		{
+			if (lo == last || time < cgltf_animation_key_time(input, lo + 1))
+			{
+				return *cursor = lo;
 			}
 
-			data->memory_free(data->memory_user_data, data->meshes[i].primitives[j].targets);
+			++lo;
 		}
-
-		data->memory_free(data->memory_user_data, data->meshes[i].primitives);
-		data->memory_free(data->memory_user_data, data->meshes[i].weights);
 	}
 
-	data->memory_free(data->memory_user_data, data->meshes);
+	cgltf_size hi = last;
 
-	for (cgltf_size i = 0; i < data->materials_count; ++i)
+	while (lo < hi)
 	{
-		data->memory_free(data->memory_user_data, data->materials[i].name);
-	}
-
-	data->memory_free(data->memory_user_data, data->materials);
+		cgltf_size mid = lo + (hi - lo + 1) / 2;
 
-	for (cgltf_size i = 0; i < data->images_count; ++i) 
-	{
-		data->memory_free(data->memory_user_data, data->images[i].name);
-		data->memory_free(data->memory_user_data, data->images[i].uri);
-		data->memory_free(data->memory_user_data, data->images[i].mime_type);
+		if (cgltf_animation_key_time(input, mid) <= time)
+		{
+			lo = mid;
+		}
+		else
+		{
+			hi = mid - 1;
+		}
 	}
 
-	data->memory_free(data->memory_user_data, data->images);
-
-	for (cgltf_size i = 0; i < data->textures_count; ++i)
+	if (cursor)
 	{
-		data->memory_free(data->memory_user_data, data->textures[i].name);
+		*cursor = lo;
 	}
 
-	data->memory_free(data->memory_user_data, data->textures);
+	return lo;
+}
 
-	data->memory_free(data->memory_user_data, data->samplers);
+static void cgltf_animation_read_value(const cgltf_accessor* output, cgltf_size element, cgltf_size components, cgltf_size first, cgltf_size count, cgltf_float* out)
+{
+	memset(out, 0, sizeof(cgltf_float) * 4);
 
-	for (cgltf_size i = 0; i < data->skins_count; ++i)
+	if (output->type == cgltf_type_scalar)
 	{
-		data->memory_free(data->memory_user_data, data->skins[i].name);
-		data->memory_free(data->memory_user_data, data->skins[i].joints);
+		for (cgltf_size i = 0; i < count; ++i)
+		{
+			cgltf_accessor_read_float(output, element * components + first + i, out + i, 1);
+		}
 	}
-
-	data->memory_free(data->memory_user_data, data->skins);
-
-	for (cgltf_size i = 0; i < data->cameras_count; ++i)
+	else
 	{
-		data->memory_free(data->memory_user_data, data->cameras[i].name);
+		cgltf_accessor_read_float(output, element, out, 4);
 	}
+}
 
-	data->memory_free(data->memory_user_data, data->cameras);
+static void cgltf_normalize_quaternion(cgltf_float* q)
+{
+	cgltf_float length = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
 
-	for (cgltf_size i = 0; i < data->lights_count; ++i)
+	if (length > 0.f)
 	{
-		data->memory_free(data->memory_user_data, data->lights[i].name);
+		q[0] /= length;
+		q[1] /= length;
+		q[2] /= length;
+		q[3] /= length;
 	}
+}
 
-	data->memory_free(data->memory_user_data, data->lights);
+static void cgltf_slerp(const cgltf_float* a, const cgltf_float* b, cgltf_float t, cgltf_float* out)
+{
+	cgltf_float dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+	cgltf_float sign = 1.f;
 
-	for (cgltf_size i = 0; i < data->nodes_count; ++i)
+	/* take the shorter arc */
+	if (dot < 0.f)
 	{
-		data->memory_free(data->memory_user_data, data->nodes[i].name);
-		data->memory_free(data->memory_user_data, data->nodes[i].children);
-		data->memory_free(data->memory_user_data, data->nodes[i].weights);
+		dot = -dot;
+		sign = -1.f;
 	}
 
-	data->memory_free(data->memory_user_data, data->nodes);
+	cgltf_float wa = 1.f - t;
+	cgltf_float wb = t;
 
-	for (cgltf_size i = 0; i < data->scenes_count; ++i)
+	/* nearly parallel rotations fall back to a normalized lerp, as sin(theta) approaches 0 */
+	if (dot < 0.9995f)
 	{
-		data->memory_free(data->memory_user_data, data->scenes[i].name);
-		data->memory_free(data->memory_user_data, data->scenes[i].nodes);
+		cgltf_float theta = acosf(dot);
+		cgltf_float sin_theta = sinf(theta);
+		wa = sinf((1.f - t) * theta) / sin_theta;
+		wb = sinf(t * theta) / sin_theta;
 	}
 
-	data->memory_free(data->memory_user_data, data->scenes);
+	wb *= sign;
 
-	for (cgltf_size i = 0; i < data->animations_count; ++i)
+	for (int i = 0; i < 4; ++i)
 	{
-		data->memory_free(data->memory_user_data, data->animations[i].name);
-		data->memory_free(data->memory_user_data, data->animations[i].samplers);
-		data->memory_free(data->memory_user_data, data->animations[i].channels);
+		out[i] = wa * a[i] + wb * b[i];
 	}
 
-	data->memory_free(data->memory_user_data, data->animations);
+	cgltf_normalize_quaternion(out);
+}
 
-	for (cgltf_size i = 0; i < data->extensions_used_count; ++i)
+cgltf_size cgltf_animation_channel_sample(const cgltf_animation_channel* channel, cgltf_float time, cgltf_size* cursor, cgltf_float* out, cgltf_size float_count)
+{
+	cgltf_size components = cgltf_animation_channel_components(channel);
+
+	if (!out)
 	{
-		data->memory_free(data->memory_user_data, data->extensions_used[i]);
+		return components;
 	}
 
-	data->memory_free(data->memory_user_data, data->extensions_used);
-
-	for (cgltf_size i = 0; i < data->extensions_required_count; ++i)
+	if (float_count < components)
 	{
-		data->memory_free(data->memory_user_data, data->extensions_required[i]);
+		return 0;
 	}
 
-	data->memory_free(data->memory_user_data, data->extensions_required);
+	memset(out, 0, sizeof(cgltf_float) * components);
 
-	data->memory_free(data->memory_user_data, data->file_data);
+	const cgltf_animation_sampler* sampler = channel->sampler;
 
-	data->memory_free(data->memory_user_data, data);
-}
+	if (!sampler || !sampler->input || !sampler->output || sampler->input->count == 0 || components == 0)
+	{
+		return components;
+	}
 
-void cgltf_node_transform_local(const cgltf_node* node, cgltf_float* out_matrix)
-{
-	cgltf_float* lm = out_matrix;
+	const cgltf_accessor* input = sampler->input;
+	const cgltf_accessor* output = sampler->output;
+	cgltf_size key_count = input->count;
+	cgltf_bool cubic = sampler->interpolation == cgltf_interpolation_type_cubic_spline;
+	cgltf_size elements_per_key = cubic ? 3 : 1;
+	cgltf_size value_offset = cubic ? 1 : 0;
 
-	if (node->has_matrix)
+	/* times outside of the keyframes hold the first or last value */
+	cgltf_size key = 0;
+	cgltf_float t0 = 0.f, t1 = 0.f;
+	cgltf_bool interpolate = 0;
+
+	if (key_count > 1 && time > cgltf_animation_key_time(input, 0))
 	{
-		memcpy(lm, node->matrix, sizeof(float) * 16);
+		if (time >= cgltf_animation_key_time(input, key_count - 1))
+		{
+			key = key_count - 1;
+		}
+		else
+		{
+			key = cgltf_animation_find_key(input, time, cursor);
+			t0 = cgltf_animation_key_time(input, key);
+			t1 = cgltf_animation_key_time(input, key + 1);
+			interpolate = sampler->interpolation != cgltf_interpolation_type_step && t1 > t0;
+		}
 	}
-	else
+
+	cgltf_float s = interpolate ? (time - t0) / (t1 - t0) : 0.f;
+	cgltf_bool rotation = channel->target_path == cgltf_animation_path_type_rotation;
+
+	/* weights are processed four at a time, other paths have at most four components */
+	for (cgltf_size first = 0; first < components; first += 4)
 	{
-		float tx = node->translation[0];
-		float ty = node->translation[1];
-		float tz = node->translation[2];
+		cgltf_size count = components - first < 4 ? components - first : 4;
+		cgltf_float v0[4], v1[4];
 
-		float qx = node->rotation[0];
-		float qy = node->rotation[1];
-		float qz = node->rotation[2];
-		float qw = node->rotation[3];
+		cgltf_animation_read_value(output, key * elements_per_key + value_offset, components, first, count, v0);
 
-		float sx = node->scale[0];
-		float sy = node->scale[1];
-		float sz = node->scale[2];
+		if (!interpolate)
+		{
+			memcpy(out + first, v0, sizeof(cgltf_float) * count);
+			continue;
+		}
 
-		lm[0] = (1 - 2 * qy*qy - 2 * qz*qz) * sx;
-		lm[1] = (2 * qx*qy + 2 * qz*qw) * sy;
-		lm[2] = (2 * qx*qz - 2 * qy*qw) * sz;
-		lm[3] = 0.f;
+		cgltf_animation_read_value(output, (key + 1) * elements_per_key + value_offset, components, first, count, v1);
 
-		lm[4] = (2 * qx*qy - 2 * qz*qw) * sx;
-		lm[5] = (1 - 2 * qx*qx - 2 * qz*qz) * sy;
-		lm[6] = (2 * qy*qz + 2 * qx*qw) * sz;
-		lm[7] = 0.f;
+		if (cubic)
+		{
+			cgltf_float b0[4], a1[4];
+			cgltf_animation_read_value(output, key * 3 + 2, components, first, count, b0);
+			cgltf_animation_read_value(output, (key + 1) * 3, components, first, count, a1);
 
-		lm[8] = (2 * qx*qz + 2 * qy*qw) * sx;
-		lm[9] = (2 * qy*qz - 2 * qx*qw) * sy;
-		lm[10] = (1 - 2 * qx*qx - 2 * qy*qy) * sz;
-		lm[11] = 0.f;
+			/* Hermite basis with the tangents scaled by the key interval */
+			cgltf_float dt = t1 - t0;
+			cgltf_float s2 = s * s;
+			cgltf_float s3 = s2 * s;
+			cgltf_float h00 = 2.f * s3 - 3.f * s2 + 1.f;
+			cgltf_float h10 = (s3 - 2.f * s2 + s) * dt;
+			cgltf_float h01 = -2.f * s3 + 3.f * s2;
+			cgltf_float h11 = (s3 - s2) * dt;
 
-		lm[12] = tx;
-		lm[13] = ty;
-		lm[14] = tz;
-		lm[15] = 1.f;
+			for (cgltf_size i = 0; i < count; ++i)
+			{
+				out[first + i] = h00 * v0[i] + h10 * b0[i] + h01 * v1[i] + h11 * a1[i];
+			}
+
+			if (rotation)
+			{
+				cgltf_normalize_quaternion(out);
+			}
+		}
+		else if (rotation)
+		{
+			cgltf_slerp(v0, v1, s, out);
+		}
+		else
+		{
+			for (cgltf_size i = 0; i < count; ++i)
+			{
+				out[first + i] = v0[i] + (v1[i] - v0[i]) * s;
+			}
+		}
 	}
+
+	return components;
 }
 
-void cgltf_node_transform_world(const cgltf_node* node, cgltf_float* out_matrix)
+cgltf_size cgltf_animation_sample(const cgltf_animation* animation, cgltf_float time, cgltf_size* cursors, cgltf_float* out_pose, cgltf_size float_count)
 {
-	cgltf_float* lm = out_matrix;
-	cgltf_node_transform_local(node, lm);
-
-	const cgltf_node* parent = node->parent;
+	cgltf_size written = 0;
 
-	while (parent)
+	for (cgltf_size i = 0; i < animation->channels_count; ++i)
 	{
-		float pm[16];
-		cgltf_node_transform_local(parent, pm);
+		const cgltf_animation_channel* channel = &animation->channels[i];
 
-		for (int i = 0; i < 4; ++i)
+		if (!out_pose)
 		{
-			float l0 = lm[i * 4 + 0];
-			float l1 = lm[i * 4 + 1];
-			float l2 = lm[i * 4 + 2];
+			written += cgltf_animation_channel_sample(channel, time, NULL, NULL, 0);
+			continue;
+		}
 
-			float r0 = l0 * pm[0] + l1 * pm[4] + l2 * pm[8];
-			float r1 = l0 * pm[1] + l1 * pm[5] + l2 * pm[9];
-			float r2 = l0 * pm[2] + l1 * pm[6] + l2 * pm[10];
+		cgltf_size components = cgltf_animation_channel_sample(channel, time, cursors ? &cursors[i] : NULL, out_pose + written, float_count - written);
 
-			lm[i * 4 + 0] = r0;
-			lm[i * 4 + 1] = r1;
-			lm[i * 4 + 2] = r2;
+		if (components == 0 && cgltf_animation_channel_components(channel) != 0)
+		{
+			break;
 		}
 
-		lm[12] += pm[12];
-		lm[13] += pm[13];
-		lm[14] += pm[14];
-
-		parent = parent->parent;
+		written += components;
 	}
+
+	return written;
 }
 
-static cgltf_size cgltf_component_read_index(const void* in, cgltf_component_type component_type)
+static cgltf_float cgltf_animation_duration(const cgltf_animation* animation)
 {
-	switch (component_type)
+	cgltf_float duration = 0.f;
+
+	for (cgltf_size i = 0; i < animation->channels_count; ++i)
 	{
-		case cgltf_component_type_r_16:
-			return *((const int16_t*) in);
-		case cgltf_component_type_r_16u:
-			return *((const uint16_t*) in);
-		case cgltf_component_type_r_32u:
-			return *((const uint32_t*) in);
-		case cgltf_component_type_r_32f:
-			return (cgltf_size)*((const float*) in);
-		case cgltf_component_type_r_8:
-			return *((const int8_t*) in);
-		case cgltf_component_type_r_8u:
-		case cgltf_component_type_invalid:
-		default:
-			return *((const uint8_t*) in);
+		const cgltf_animation_sampler* sampler = animation->channels[i].sampler;
+
+		if (sampler && sampler->input && sampler->input->count)
+		{
+			cgltf_float last = cgltf_animation_key_time(sampler->input, sampler->input->count - 1);
+			duration = last > duration ? last : duration;
+		}
 	}
+
+	return duration;
 }
 
-static cgltf_float cgltf_component_read_float(const void* in, cgltf_component_type component_type, cgltf_bool normalized)
+static short cgltf_quantize_snorm16(cgltf_float value)
 {
-	if (component_type == cgltf_component_type_r_32f)
+	value = value < -1.f ? -1.f : (value > 1.f ? 1.f : value);
+	return (short)(value * 32767.f + (value >= 0.f ? 0.5f : -0.5f));
+}
+
+cgltf_result cgltf_bake_animation(const cgltf_options* options, const cgltf_animation* animation, cgltf_float frame_rate, cgltf_bool quantize_rotations, cgltf_baked_animation** out_baked)
+{
+	if (options == NULL || animation == NULL || out_baked == NULL || !(frame_rate > 0.f))
+	{
+		return cgltf_result_invalid_options;
+	}
+
+	void* (*memory_alloc)(void*, cgltf_size) = options->memory_alloc ? options->memory_alloc : &cgltf_default_alloc;
+	void (*memory_free)(void*, void*) = options->memory_free ? options->memory_free : &cgltf_default_free;
+
+	cgltf_size float_count = 0;
+	cgltf_size quantized_count = 0;
+
+	for (cgltf_size i = 0; i < animation->channels_count; ++i)
+	{
+		const cgltf_animation_channel* channel = &animation->channels[i];
+
+		if (quantize_rotations && channel->target_path == cgltf_animation_path_type_rotation)
+		{
+			quantized_count += 4;
+		}
+		else
+		{
+			float_count += cgltf_animation_channel_components(channel);
+		}
+	}
+
+	/* the clip covers [0, duration] with a frame at each end */
+	cgltf_float frames = ceilf(cgltf_animation_duration(animation) * frame_rate);
+	cgltf_size values_per_frame = float_count + quantized_count;
+
+	if (!(frames < (cgltf_float)(SIZE_MAX / 64)) || (values_per_frame && (cgltf_size)frames + 1 > SIZE_MAX / 8 / values_per_frame))
+	{
+		return cgltf_result_out_of_memory;
+	}
+
+	cgltf_size frame_count = (cgltf_size)frames + 1;
+	cgltf_size size = sizeof(cgltf_baked_animation) + sizeof(cgltf_baked_channel) * animation->channels_count +
+		sizeof(cgltf_float) * float_count * frame_count + sizeof(short) * quantized_count * frame_count;
+
+	uint8_t* memory = (uint8_t*)memory_alloc(options->memory_user_data, size);
+	if (!memory)
 	{
-		return *((const float*) in);
+		return cgltf_result_out_of_memory;
 	}
 
-	if (normalized)
+	cgltf_baked_animation* baked = (cgltf_baked_animation*)memory;
+	memset(baked, 0, sizeof(cgltf_baked_animation));
+	baked->frame_rate = frame_rate;
+	baked->frame_count = frame_count;
+	baked->channels = (cgltf_baked_channel*)(memory + sizeof(cgltf_baked_animation));
+	baked->channels_count = animation->channels_count;
+	baked->memory_free = memory_free;
+	baked->memory_user_data = options->memory_user_data;
+
+	cgltf_float* values = (cgltf_float*)(baked->channels + animation->channels_count);
+	short* quantized_values = (short*)(values + float_count * frame_count);
+
+	for (cgltf_size i = 0; i < animation->channels_count; ++i)
 	{
-		switch (component_type)
+		const cgltf_animation_channel* channel = &animation->channels[i];
+		cgltf_baked_channel* baked_channel = &baked->channels[i];
+		cgltf_size components = cgltf_animation_channel_components(channel);
+		cgltf_bool rotation = channel->target_path == cgltf_animation_path_type_rotation;
+
+		baked_channel->channel = channel;
+		baked_channel->target_path = channel->target_path;
+		baked_channel->components = components;
+		baked_channel->step = channel->sampler && channel->sampler->interpolation == cgltf_interpolation_type_step;
+		baked_channel->rotation = rotation && components == 4;
+		baked_channel->values = NULL;
+		baked_channel->quantized_values = NULL;
+
+		if (components == 0)
 		{
-			case cgltf_component_type_r_32u:
-				return *((const uint32_t*) in) / (float) UINT_MAX;
-			case cgltf_component_type_r_16:
-				return *((const int16_t*) in) / (float) SHRT_MAX;
-			case cgltf_component_type_r_16u:
-				return *((const uint16_t*) in) / (float) USHRT_MAX;
-			case cgltf_component_type_r_8:
-				return *((const int8_t*) in) / (float) SCHAR_MAX;
-			case cgltf_component_type_r_8u:
-			case cgltf_component_type_invalid:
-			default:
-				return *((const uint8_t*) in) / (float) CHAR_MAX;
+			continue;
 		}
-	}
 
-	return (cgltf_float)cgltf_component_read_index(in, component_type);
-}
+		if (quantize_rotations && rotation)
+		{
+			baked_channel->quantized_values = quantized_values;
+			quantized_values += 4 * frame_count;
+		}
+		else
+		{
+			baked_channel->values = values;
+			values += components * frame_count;
+		}
 
-static cgltf_size cgltf_num_components(cgltf_type type);
-static cgltf_size cgltf_component_size(cgltf_component_type component_type);
+		cgltf_size cursor = 0;
+		cgltf_float previous[4] = { 0.f, 0.f, 0.f, 1.f };
 
-static cgltf_bool cgltf_element_read_float(const uint8_t* element, cgltf_type type, cgltf_component_type component_type, cgltf_bool normalized, cgltf_float* out, cgltf_size element_size)
-{
-	cgltf_size num_components = cgltf_num_components(type);
+		for (cgltf_size frame = 0; frame < frame_count; ++frame)
+		{
+			cgltf_float time = (cgltf_float)frame / frame_rate;
 
-	if (element_size < num_components) {
-		return 0;
-	}
+			if (!rotation)
+			{
+				cgltf_animation_channel_sample(channel, time, &cursor, baked_channel->values + frame * components, components);
+				continue;
+			}
 
-	// There are three special cases for component extraction, see #data-alignment in the 2.0 spec.
+			cgltf_float value[4];
+			cgltf_animation_channel_sample(channel, time, &cursor, value, 4);
 
-	cgltf_size component_size = cgltf_component_size(component_type);
+			/* keep consecutive frames in the same hemisphere so that they can be interpolated linearly */
+			if (value[0] * previous[0] + value[1] * previous[1] + value[2] * previous[2] + value[3] * previous[3] < 0.f)
+			{
+				value[0] = -value[0];
+				value[1] = -value[1];
+				value[2] = -value[2];
+				value[3] = -value[3];
+			}
 
-	if (type == cgltf_type_mat2 && component_size == 1)
-	{
-		out[0] = cgltf_component_read_float(element, component_type, normalized);
-		out[1] = cgltf_component_read_float(element + 1, component_type, normalized);
-		out[2] = cgltf_component_read_float(element + 4, component_type, normalized);
-		out[3] = cgltf_component_read_float(element + 5, component_type, normalized);
-		return 1;
+			memcpy(previous, value, sizeof(previous));
+
+			for (int c = 0; c < 4; ++c)
+			{
+				if (baked_channel->quantized_values)
+				{
+					baked_channel->quantized_values[frame * 4 + c] = cgltf_quantize_snorm16(value[c]);
+				}
+				else
+				{
+					baked_channel->values[frame * 4 + c] = value[c];
+				}
+			}
+		}
 	}
 
-	if (type == cgltf_type_mat3 && component_size == 1)
+	*out_baked = baked;
+
+	return cgltf_result_success;
+}
+
+cgltf_size cgltf_baked_animation_sample(const cgltf_baked_animation* baked, cgltf_float time, cgltf_float* out_pose, cgltf_size float_count)
+{
+	cgltf_size written = 0;
+
+	if (!out_pose)
 	{
-		out[0] = cgltf_component_read_float(element, component_type, normalized);
-		out[1] = cgltf_component_read_float(element + 1, component_type, normalized);
-		out[2] = cgltf_component_read_float(element + 2, component_type, normalized);
-		out[3] = cgltf_component_read_float(element + 4, component_type, normalized);
-		out[4] = cgltf_component_read_float(element + 5, component_type, normalized);
-		out[5] = cgltf_component_read_float(element + 6, component_type, normalized);
-		out[6] = cgltf_component_read_float(element + 8, component_type, normalized);
-		out[7] = cgltf_component_read_float(element + 9, component_type, normalized);
-		out[8] = cgltf_component_read_float(element + 10, component_type, normalized);
-		return 1;
+		for (cgltf_size i = 0; i < baked->channels_count; ++i)
+		{
+			written += baked->channels[i].components;
+		}
+
+		return written;
 	}
 
-	if (type == cgltf_type_mat3 && component_size == 2)
+	/* frame index and blend factor, clamped to the clip */
+	cgltf_float position = time * baked->frame_rate;
+	cgltf_size last = baked->frame_count - 1;
+	cgltf_size frame = 0;
+	cgltf_float s = 0.f;
+
+	if (position >= (cgltf_float)last)
 	{
-		out[0] = cgltf_component_read_float(element, component_type, normalized);
-		out[1] = cgltf_component_read_float(element + 2, component_type, normalized);
-		out[2] = cgltf_component_read_float(element + 4, component_type, normalized);
-		out[3] = cgltf_component_read_float(element + 8, component_type, normalized);
-		out[4] = cgltf_component_read_float(element + 10, component_type, normalized);
-		out[5] = cgltf_component_read_float(element + 12, component_type, normalized);
-		out[6] = cgltf_component_read_float(element + 16, component_type, normalized);
-		out[7] = cgltf_component_read_float(element + 18, component_type, normalized);
-		out[8] = cgltf_component_read_float(element + 20, component_type, normalized);
-		return 1;
+		frame = last;
 	}
-
-	for (cgltf_size i = 0; i < num_components; ++i)
+	else if (position > 0.f)
 	{
-		out[i] = cgltf_component_read_float(element + component_size * i, component_type, normalized);
+		frame = (cgltf_size)position;
+		s = position - (cgltf_float)frame;
 	}
-	return 1;
-}
 
+	cgltf_size next = frame < last ? frame + 1 : last;
 
-cgltf_bool cgltf_accessor_read_float(const cgltf_accessor* accessor, cgltf_size index, cgltf_float* out, cgltf_size element_size)
-{
-	if (accessor->is_sparse || accessor->buffer_view == NULL)
+	for (cgltf_size i = 0; i < baked->channels_count; ++i)
 	{
-		return 0;
+		const cgltf_baked_channel* channel = &baked->channels[i];
+		cgltf_size components = channel->components;
+
+		if (written + components > float_count)
+		{
+			break;
+		}
+
+		cgltf_float* out = out_pose + written;
+		cgltf_float t = channel->step ? 0.f : s;
+
+		if (channel->quantized_values)
+		{
+			const short* a = channel->quantized_values + frame * 4;
+			const short* b = channel->quantized_values + next * 4;
+
+			for (int c = 0; c < 4; ++c)
+			{
+				cgltf_float va = (cgltf_float)a[c] * (1.f / 32767.f);
+				cgltf_float vb = (cgltf_float)b[c] * (1.f / 32767.f);
+				out[c] = va + (vb - va) * t;
+			}
+		}
+		else if (channel->values)
+		{
+			const cgltf_float* a = channel->values + frame * components;
+			const cgltf_float* b = channel->values + next * components;
+
+			for (cgltf_size c = 0; c < components; ++c)
+			{
+				out[c] = a[c] + (b[c] - a[c]) * t;
+			}
+		}
+
+		if (channel->rotation)
+		{
+			cgltf_normalize_quaternion(out);
+		}
+
+		written += components;
 	}
 
-	cgltf_size offset = accessor->offset + accessor->buffer_view->offset;
-	const uint8_t* element = (const uint8_t*) accessor->buffer_view->buffer->data;
-	element += offset + accessor->stride * index;
-	return cgltf_element_read_float(element, accessor->type, accessor->component_type, accessor->normalized, out, element_size);
+	return written;
 }
 
-cgltf_size cgltf_accessor_read_index(const cgltf_accessor* accessor, cgltf_size index)
+void cgltf_free_baked_animation(cgltf_baked_animation* baked)
 {
-	if (accessor->buffer_view)
+	if (!baked)
 	{
-		cgltf_size offset = accessor->offset + accessor->buffer_view->offset;
-		const uint8_t* element = (const uint8_t*) accessor->buffer_view->buffer->data;
-		element += offset + accessor->stride * index;
-		return cgltf_component_read_index(element, accessor->component_type);
+		return;
 	}
 
-	return 0;
+	baked->memory_free(baked->memory_user_data, baked);
 }
 
 #define CGLTF_ERROR_JSON -1
@@ -1651,24 +4977,132 @@ static int cgltf_json_strcmp(jsmntok_t const* tok, const uint8_t* json_chunk, co
 	return (str_len == name_length) ? strncmp((const char*)json_chunk + tok->start, str, str_len) : 128;
 }
 
+/* Object keys are matched by comparing their length and first 7 characters packed into an integer, which
+ * the compiler folds to a constant for string literals, so most mismatching keys cost a single compare */
+static uint64_t cgltf_json_key(jsmntok_t const* tok, const uint8_t* json_chunk)
+{
+	size_t const length = tok->end - tok->start;
+	uint64_t key = length < 255 ? length : 255;
+
+	for (size_t k = 0; k < 7 && k < length; ++k)
+	{
+		key |= (uint64_t)json_chunk[tok->start + k] << (8 * (k + 1));
+	}
+
+	return key;
+}
+
+#define CGLTF_JSON_KEY_CHAR(str_, k_) (sizeof(str_) - 1 > (k_) ? (uint64_t)(uint8_t)(str_)[sizeof(str_) - 1 > (k_) ? (k_) : 0] << (8 * ((k_) + 1)) : 0)
+#define CGLTF_JSON_KEY(str_) ((uint64_t)(sizeof(str_) - 1) | CGLTF_JSON_KEY_CHAR(str_, 0) | CGLTF_JSON_KEY_CHAR(str_, 1) | CGLTF_JSON_KEY_CHAR(str_, 2) | \
+	CGLTF_JSON_KEY_CHAR(str_, 3) | CGLTF_JSON_KEY_CHAR(str_, 4) | CGLTF_JSON_KEY_CHAR(str_, 5) | CGLTF_JSON_KEY_CHAR(str_, 6))
+#define CGLTF_JSON_KEY_EQUAL(key_, tok_, json_chunk_, str_) ((key_) == CGLTF_JSON_KEY(str_) && \
+	(sizeof(str_) <= 8 || memcmp((const char*)(json_chunk_) + (tok_)->start + 7, (const char*)(str_) + (sizeof(str_) <= 8 ? 0 : 7), sizeof(str_) <= 8 ? 0 : sizeof(str_) - 8) == 0))
+
 static int cgltf_json_to_int(jsmntok_t const* tok, const uint8_t* json_chunk)
 {
 	CGLTF_CHECK_TOKTYPE(*tok, JSMN_PRIMITIVE);
+	const char* str = (const char*)json_chunk + tok->start;
+	const char* end = (const char*)json_chunk + tok->end;
+
+	int negative = str < end && *str == '-';
+	str += (str < end && (*str == '-' || *str == '+'));
+
+	// Like atoi, this parses the leading integer, so "1.5" and "1e3" yield 1
+	long long value = 0;
+	for (; str < end && *str >= '0' && *str <= '9'; ++str)
+	{
+		value = value * 10 + (*str - '0');
+		value = value > (long long)INT_MAX + 1 ? (long long)INT_MAX + 1 : value;
+	}
+
+	value = negative ? -value : value;
+	return value > INT_MAX ? INT_MAX : (int)value;
+}
+
+static cgltf_float cgltf_json_to_float_slow(const char* str, cgltf_size size)
+{
 	char tmp[128];
-	int size = (cgltf_size)(tok->end - tok->start) < sizeof(tmp) ? tok->end - tok->start : sizeof(tmp) - 1;
-	strncpy(tmp, (const char*)json_chunk + tok->start, size);
+	size = size < sizeof(tmp) ? size : sizeof(tmp) - 1;
+	memcpy(tmp, str, size);
 	tmp[size] = 0;
-	return atoi(tmp);
+
+	// strtof expects the decimal point of the current locale, which isn't always '.'
+	char decimal_point = *localeconv()->decimal_point;
+	for (cgltf_size i = 0; i < size; ++i)
+	{
+		tmp[i] = tmp[i] == '.' ? decimal_point : tmp[i];
+	}
+
+	return strtof(tmp, NULL);
 }
 
 static cgltf_float cgltf_json_to_float(jsmntok_t const* tok, const uint8_t* json_chunk)
 {
 	CGLTF_CHECK_TOKTYPE(*tok, JSMN_PRIMITIVE);
-	char tmp[128];
-	int size = (cgltf_size)(tok->end - tok->start) < sizeof(tmp) ? tok->end - tok->start : sizeof(tmp) - 1;
-	strncpy(tmp, (const char*)json_chunk + tok->start, size);
-	tmp[size] = 0;
-	return (cgltf_float)atof(tmp);
+	const char* str = (const char*)json_chunk + tok->start;
+	const char* end = (const char*)json_chunk + tok->end;
+
+	int negative = str < end && *str == '-';
+	const char* digits = str + negative;
+
+	uint64_t mantissa = 0;
+	int significant_digits = 0;
+	int exponent = 0;
+	const char* ptr = digits;
+
+	for (; ptr < end && *ptr >= '0' && *ptr <= '9'; ++ptr)
+	{
+		mantissa = mantissa * 10 + (*ptr - '0');
+		significant_digits += significant_digits || mantissa;
+	}
+
+	cgltf_bool has_digits = ptr != digits;
+
+	if (ptr < end && *ptr == '.')
+	{
+		const char* fraction = ++ptr;
+
+		for (; ptr < end && *ptr >= '0' && *ptr <= '9'; ++ptr)
+		{
+			mantissa = mantissa * 10 + (*ptr - '0');
+			significant_digits += significant_digits || mantissa;
+		}
+
+		exponent -= (int)(ptr - fraction);
+		has_digits |= ptr != fraction;
+	}
+
+	if (has_digits && ptr < end && (*ptr == 'e' || *ptr == 'E'))
+	{
+		++ptr;
+		int exponent_negative = ptr < end && *ptr == '-';
+		ptr += (ptr < end && (*ptr == '-' || *ptr == '+'));
+
+		int exponent_value = 0;
+		for (; ptr < end && *ptr >= '0' && *ptr <= '9'; ++ptr)
+		{
+			exponent_value = exponent_value < 10000 ? exponent_value * 10 + (*ptr - '0') : exponent_value;
+		}
+
+		exponent += exponent_negative ? -exponent_value : exponent_value;
+	}
+
+	// Clinger's fast path: both the mantissa and the power of 10 are exact floats, so a single multiplication
+	// or division rounds correctly; going through a double would round twice, so everything else, including
+	// malformed numbers, goes through strtof
+	static const float powers_of_10[] = {
+		1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+	};
+
+	if (!has_digits || ptr != end || significant_digits > 19 || mantissa > ((uint64_t)1 << 24) || exponent < -10 || exponent > 10)
+	{
+		return cgltf_json_to_float_slow(str, end - str);
+	}
+
+	float value = (float)mantissa;
+	value = exponent < 0 ? value / powers_of_10[-exponent] : value * powers_of_10[exponent];
+
+	return negative ? -value : value;
 }
 
 static cgltf_bool cgltf_json_to_bool(jsmntok_t const* tok, const uint8_t* json_chunk)
@@ -1740,6 +5174,14 @@ static int cgltf_parse_json_string(cgltf_options* options, jsmntok_t const* toke
 		return CGLTF_ERROR_JSON;
 	}
 	int size = tokens[i].end - tokens[i].start;
+	if (options->in_place_strings)
+	{
+		// The closing quote becomes the terminator, the token already holds the bounds of the string
+		char* result = (char*)json_chunk + tokens[i].start;
+		result[size] = 0;
+		*out_string = result;
+		return i + 1;
+	}
 	char* result = (char*)options->memory_alloc(options->memory_user_data, size + 1);
 	if (!result)
 	{
@@ -1893,7 +5335,9 @@ static int cgltf_parse_json_primitive(cgltf_options* options, jsmntok_t const* t
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "mode") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "mode"))
 		{
 			++i;
 			out_prim->type
@@ -1901,23 +5345,23 @@ static int cgltf_parse_json_primitive(cgltf_options* options, jsmntok_t const* t
 					cgltf_json_to_int(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "indices") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "indices"))
 		{
 			++i;
 			out_prim->indices = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "material") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "material"))
 		{
 			++i;
 			out_prim->material = CGLTF_PTRINDEX(cgltf_material, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "attributes") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "attributes"))
 		{
 			i = cgltf_parse_json_attribute_list(options, tokens, i + 1, json_chunk, &out_prim->attributes, &out_prim->attributes_count);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "targets") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "targets"))
 		{
 			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_morph_target), (void**)&out_prim->targets, &out_prim->targets_count);
 			if (i < 0)
@@ -1934,7 +5378,7 @@ static int cgltf_parse_json_primitive(cgltf_options* options, jsmntok_t const* t
 				}
 			}
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_prim->extras);
 		}
@@ -1963,11 +5407,13 @@ static int cgltf_parse_json_mesh(cgltf_options* options, jsmntok_t const* tokens
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "name"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_mesh->name);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "primitives") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "primitives"))
 		{
 			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_primitive), (void**)&out_mesh->primitives, &out_mesh->primitives_count);
 			if (i < 0)
@@ -1984,7 +5430,7 @@ static int cgltf_parse_json_mesh(cgltf_options* options, jsmntok_t const* tokens
 				}
 			}
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "weights") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "weights"))
 		{
 			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_float), (void**)&out_mesh->weights, &out_mesh->weights_count);
 			if (i < 0)
@@ -1994,7 +5440,7 @@ static int cgltf_parse_json_mesh(cgltf_options* options, jsmntok_t const* tokens
 
 			i = cgltf_parse_json_float_array(tokens, i - 1, json_chunk, out_mesh->weights, (int)out_mesh->weights_count);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_mesh->extras);
 		}
@@ -2065,13 +5511,15 @@ static int cgltf_parse_json_accessor_sparse(jsmntok_t const* tokens, int i, cons
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "count") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "count"))
 		{
 			++i;
 			out_sparse->count = cgltf_json_to_int(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "indices") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "indices"))
 		{
 			++i;
 			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
@@ -2083,25 +5531,27 @@ static int cgltf_parse_json_accessor_sparse(jsmntok_t const* tokens, int i, cons
 			{
 				CGLTF_CHECK_KEY(tokens[i]);
 
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
+				uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+				if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "bufferView"))
 				{
 					++i;
 					out_sparse->indices_buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "byteOffset"))
 				{
 					++i;
 					out_sparse->indices_byte_offset = cgltf_json_to_int(tokens + i, json_chunk);
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "componentType") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "componentType"))
 				{
 					++i;
 					out_sparse->indices_component_type = cgltf_json_to_component_type(tokens + i, json_chunk);
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 				{
 					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sparse->indices_extras);
 				}
@@ -2116,7 +5566,7 @@ static int cgltf_parse_json_accessor_sparse(jsmntok_t const* tokens, int i, cons
 				}
 			}
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "values") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "values"))
 		{
 			++i;
 			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
@@ -2128,19 +5578,21 @@ static int cgltf_parse_json_accessor_sparse(jsmntok_t const* tokens, int i, cons
 			{
 				CGLTF_CHECK_KEY(tokens[i]);
 
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
+				uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+				if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "bufferView"))
 				{
 					++i;
 					out_sparse->values_buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "byteOffset"))
 				{
 					++i;
 					out_sparse->values_byte_offset = cgltf_json_to_int(tokens + i, json_chunk);
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 				{
 					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sparse->values_extras);
 				}
@@ -2155,7 +5607,7 @@ static int cgltf_parse_json_accessor_sparse(jsmntok_t const* tokens, int i, cons
 				}
 			}
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sparse->extras);
 		}
@@ -2184,39 +5636,41 @@ static int cgltf_parse_json_accessor(jsmntok_t const* tokens, int i, const uint8
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "bufferView"))
 		{
 			++i;
 			out_accessor->buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "byteOffset"))
 		{
 			++i;
 			out_accessor->offset =
 					cgltf_json_to_int(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "componentType") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "componentType"))
 		{
 			++i;
 			out_accessor->component_type = cgltf_json_to_component_type(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "normalized") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "normalized"))
 		{
 			++i;
 			out_accessor->normalized = cgltf_json_to_bool(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "count") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "count"))
 		{
 			++i;
 			out_accessor->count =
 					cgltf_json_to_int(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "type") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "type"))
 		{
 			++i;
 			if (cgltf_json_strcmp(tokens+i, json_chunk, "SCALAR") == 0)
@@ -2249,7 +5703,7 @@ static int cgltf_parse_json_accessor(jsmntok_t const* tokens, int i, const uint8
 			}
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "min") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "min"))
 		{
 			++i;
 			out_accessor->has_min = 1;
@@ -2257,7 +5711,7 @@ static int cgltf_parse_json_accessor(jsmntok_t const* tokens, int i, const uint8
 			int min_size = tokens[i].size > 16 ? 16 : tokens[i].size;
 			i = cgltf_parse_json_float_array(tokens, i, json_chunk, out_accessor->min, min_size);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "max") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "max"))
 		{
 			++i;
 			out_accessor->has_max = 1;
@@ -2265,12 +5719,12 @@ static int cgltf_parse_json_accessor(jsmntok_t const* tokens, int i, const uint8
 			int max_size = tokens[i].size > 16 ? 16 : tokens[i].size;
 			i = cgltf_parse_json_float_array(tokens, i, json_chunk, out_accessor->max, max_size);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "sparse") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "sparse"))
 		{
 			out_accessor->is_sparse = 1;
 			i = cgltf_parse_json_accessor_sparse(tokens, i + 1, json_chunk, &out_accessor->sparse);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_accessor->extras);
 		}
@@ -2299,21 +5753,23 @@ static int cgltf_parse_json_texture_transform(jsmntok_t const* tokens, int i, co
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "offset") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "offset"))
 		{
 			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_texture_transform->offset, 2);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "rotation") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "rotation"))
 		{
 			++i;
 			out_texture_transform->rotation = cgltf_json_to_float(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "scale") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "scale"))
 		{
 			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_texture_transform->scale, 2);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "texCoord") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "texCoord"))
 		{
 			++i;
 			out_texture_transform->texcoord = cgltf_json_to_int(tokens + i, json_chunk);
@@ -2347,35 +5803,37 @@ static int cgltf_parse_json_texture_view(jsmntok_t const* tokens, int i, const u
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "index") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "index"))
 		{
 			++i;
 			out_texture_view->texture = CGLTF_PTRINDEX(cgltf_texture, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "texCoord") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "texCoord"))
 		{
 			++i;
 			out_texture_view->texcoord = cgltf_json_to_int(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "scale") == 0) 
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "scale")) 
 		{
 			++i;
 			out_texture_view->scale = cgltf_json_to_float(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "strength") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "strength"))
 		{
 			++i;
 			out_texture_view->scale = cgltf_json_to_float(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_texture_view->extras);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extensions"))
 		{
 			++i;
 
@@ -2388,7 +5846,9 @@ static int cgltf_parse_json_texture_view(jsmntok_t const* tokens, int i, const u
 			{
 				CGLTF_CHECK_KEY(tokens[i]);
 
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_texture_transform") == 0)
+				uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+				if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "KHR_texture_transform"))
 				{
 					out_texture_view->has_transform = 1;
 					i = cgltf_parse_json_texture_transform(tokens, i + 1, json_chunk, &out_texture_view->transform);
@@ -2429,35 +5889,37 @@ static int cgltf_parse_json_pbr_metallic_roughness(jsmntok_t const* tokens, int
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "metallicFactor") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "metallicFactor"))
 		{
 			++i;
 			out_pbr->metallic_factor = 
 				cgltf_json_to_float(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "roughnessFactor") == 0) 
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "roughnessFactor")) 
 		{
 			++i;
 			out_pbr->roughness_factor =
 				cgltf_json_to_float(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "baseColorFactor") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "baseColorFactor"))
 		{
 			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_pbr->base_color_factor, 4);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "baseColorTexture") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "baseColorTexture"))
 		{
 			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
 				&out_pbr->base_color_texture);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "metallicRoughnessTexture") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "metallicRoughnessTexture"))
 		{
 			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
 				&out_pbr->metallic_roughness_texture);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_pbr->extras);
 		}
@@ -2485,25 +5947,27 @@ static int cgltf_parse_json_pbr_specular_glossiness(jsmntok_t const* tokens, int
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "diffuseFactor") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "diffuseFactor"))
 		{
 			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_pbr->diffuse_factor, 4);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "specularFactor") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "specularFactor"))
 		{
 			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_pbr->specular_factor, 3);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "glossinessFactor") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "glossinessFactor"))
 		{
 			++i;
 			out_pbr->glossiness_factor = cgltf_json_to_float(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "diffuseTexture") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "diffuseTexture"))
 		{
 			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk, &out_pbr->diffuse_texture);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "specularGlossinessTexture") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "specularGlossinessTexture"))
 		{
 			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk, &out_pbr->specular_glossiness_texture);
 		}
@@ -2532,25 +5996,27 @@ static int cgltf_parse_json_image(cgltf_options* options, jsmntok_t const* token
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "uri") == 0) 
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "uri")) 
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_image->uri);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "bufferView"))
 		{
 			++i;
 			out_image->buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "mimeType") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "mimeType"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_image->mime_type);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "name") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "name"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_image->name);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_image->extras);
 		}
@@ -2583,35 +6049,37 @@ static int cgltf_parse_json_sampler(cgltf_options* options, jsmntok_t const* tok
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "magFilter") == 0) 
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "magFilter")) 
 		{
 			++i;
 			out_sampler->mag_filter
 				= cgltf_json_to_int(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "minFilter") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "minFilter"))
 		{
 			++i;
 			out_sampler->min_filter
 				= cgltf_json_to_int(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "wrapS") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "wrapS"))
 		{
 			++i;
 			out_sampler->wrap_s
 				= cgltf_json_to_int(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "wrapT") == 0) 
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "wrapT")) 
 		{
 			++i;
 			out_sampler->wrap_t
 				= cgltf_json_to_int(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sampler->extras);
 		}
@@ -2641,23 +6109,25 @@ static int cgltf_parse_json_texture(cgltf_options* options, jsmntok_t const* tok
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "name"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_texture->name);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "sampler") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "sampler"))
 		{
 			++i;
 			out_texture->sampler = CGLTF_PTRINDEX(cgltf_sampler, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "source") == 0) 
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "source")) 
 		{
 			++i;
 			out_texture->image = CGLTF_PTRINDEX(cgltf_image, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_texture->extras);
 		}
@@ -2696,35 +6166,37 @@ static int cgltf_parse_json_material(cgltf_options* options, jsmntok_t const* to
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "name"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_material->name);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "pbrMetallicRoughness") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "pbrMetallicRoughness"))
 		{
 			out_material->has_pbr_metallic_roughness = 1;
 			i = cgltf_parse_json_pbr_metallic_roughness(tokens, i + 1, json_chunk, &out_material->pbr_metallic_roughness);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "emissiveFactor") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "emissiveFactor"))
 		{
 			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_material->emissive_factor, 3);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "normalTexture") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "normalTexture"))
 		{
 			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
 				&out_material->normal_texture);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "occlusionTexture") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "occlusionTexture"))
 		{
 			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
 				&out_material->occlusion_texture);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "emissiveTexture") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "emissiveTexture"))
 		{
 			i = cgltf_parse_json_texture_view(tokens, i + 1, json_chunk,
 				&out_material->emissive_texture);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "alphaMode") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "alphaMode"))
 		{
 			++i;
 			if (cgltf_json_strcmp(tokens + i, json_chunk, "OPAQUE") == 0)
@@ -2741,24 +6213,24 @@ static int cgltf_parse_json_material(cgltf_options* options, jsmntok_t const* to
 			}
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "alphaCutoff") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "alphaCutoff"))
 		{
 			++i;
 			out_material->alpha_cutoff = cgltf_json_to_float(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "doubleSided") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "doubleSided"))
 		{
 			++i;
 			out_material->double_sided =
 				cgltf_json_to_bool(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_material->extras);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extensions"))
 		{
 			++i;
 
@@ -2771,12 +6243,14 @@ static int cgltf_parse_json_material(cgltf_options* options, jsmntok_t const* to
 			{
 				CGLTF_CHECK_KEY(tokens[i]);
 
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_materials_pbrSpecularGlossiness") == 0)
+				uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+				if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "KHR_materials_pbrSpecularGlossiness"))
 				{
 					out_material->has_pbr_specular_glossiness = 1;
 					i = cgltf_parse_json_pbr_specular_glossiness(tokens, i + 1, json_chunk, &out_material->pbr_specular_glossiness);
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_materials_unlit") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "KHR_materials_unlit"))
 				{
 					out_material->unlit = 1;
 					i = cgltf_skip_json(tokens, i+1);
@@ -2912,34 +6386,36 @@ static int cgltf_parse_json_buffer_view(jsmntok_t const* tokens, int i, const ui
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "buffer") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "buffer"))
 		{
 			++i;
 			out_buffer_view->buffer = CGLTF_PTRINDEX(cgltf_buffer, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "byteOffset"))
 		{
 			++i;
 			out_buffer_view->offset =
 					cgltf_json_to_int(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteLength") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "byteLength"))
 		{
 			++i;
 			out_buffer_view->size =
 					cgltf_json_to_int(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteStride") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "byteStride"))
 		{
 			++i;
 			out_buffer_view->stride =
 					cgltf_json_to_int(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "target") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "target"))
 		{
 			++i;
 			int type = cgltf_json_to_int(tokens+i, json_chunk);
@@ -2958,7 +6434,7 @@ static int cgltf_parse_json_buffer_view(jsmntok_t const* tokens, int i, const ui
 			out_buffer_view->type = (cgltf_buffer_view_type)type;
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_buffer_view->extras);
 		}
@@ -3006,18 +6482,20 @@ static int cgltf_parse_json_buffer(cgltf_options* options, jsmntok_t const* toke
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "byteLength") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "byteLength"))
 		{
 			++i;
 			out_buffer->size =
 					cgltf_json_to_int(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "uri") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "uri"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_buffer->uri);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_buffer->extras);
 		}
@@ -3065,11 +6543,13 @@ static int cgltf_parse_json_skin(cgltf_options* options, jsmntok_t const* tokens
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "name"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_skin->name);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "joints") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "joints"))
 		{
 			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_node*), (void**)&out_skin->joints, &out_skin->joints_count);
 			if (i < 0)
@@ -3083,21 +6563,21 @@ static int cgltf_parse_json_skin(cgltf_options* options, jsmntok_t const* tokens
 				++i;
 			}
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "skeleton") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "skeleton"))
 		{
 			++i;
 			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
 			out_skin->skeleton = CGLTF_PTRINDEX(cgltf_node, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "inverseBindMatrices") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "inverseBindMatrices"))
 		{
 			++i;
 			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
 			out_skin->inverse_bind_matrices = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_skin->extras);
 		}
@@ -3145,11 +6625,13 @@ static int cgltf_parse_json_camera(cgltf_options* options, jsmntok_t const* toke
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "name"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_camera->name);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "type") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "type"))
 		{
 			++i;
 			if (cgltf_json_strcmp(tokens + i, json_chunk, "perspective") == 0)
@@ -3162,7 +6644,7 @@ static int cgltf_parse_json_camera(cgltf_options* options, jsmntok_t const* toke
 			}
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "perspective") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "perspective"))
 		{
 			++i;
 
@@ -3177,31 +6659,33 @@ static int cgltf_parse_json_camera(cgltf_options* options, jsmntok_t const* toke
 			{
 				CGLTF_CHECK_KEY(tokens[i]);
 
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "aspectRatio") == 0)
+				uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+				if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "aspectRatio"))
 				{
 					++i;
 					out_camera->perspective.aspect_ratio = cgltf_json_to_float(tokens + i, json_chunk);
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "yfov") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "yfov"))
 				{
 					++i;
 					out_camera->perspective.yfov = cgltf_json_to_float(tokens + i, json_chunk);
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "zfar") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "zfar"))
 				{
 					++i;
 					out_camera->perspective.zfar = cgltf_json_to_float(tokens + i, json_chunk);
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "znear") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "znear"))
 				{
 					++i;
 					out_camera->perspective.znear = cgltf_json_to_float(tokens + i, json_chunk);
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 				{
 					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_camera->perspective.extras);
 				}
@@ -3216,7 +6700,7 @@ static int cgltf_parse_json_camera(cgltf_options* options, jsmntok_t const* toke
 				}
 			}
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "orthographic") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "orthographic"))
 		{
 			++i;
 
@@ -3231,31 +6715,33 @@ static int cgltf_parse_json_camera(cgltf_options* options, jsmntok_t const* toke
 			{
 				CGLTF_CHECK_KEY(tokens[i]);
 
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "xmag") == 0)
+				uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+				if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "xmag"))
 				{
 					++i;
 					out_camera->orthographic.xmag = cgltf_json_to_float(tokens + i, json_chunk);
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "ymag") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "ymag"))
 				{
 					++i;
 					out_camera->orthographic.ymag = cgltf_json_to_float(tokens + i, json_chunk);
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "zfar") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "zfar"))
 				{
 					++i;
 					out_camera->orthographic.zfar = cgltf_json_to_float(tokens + i, json_chunk);
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "znear") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "znear"))
 				{
 					++i;
 					out_camera->orthographic.znear = cgltf_json_to_float(tokens + i, json_chunk);
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 				{
 					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_camera->orthographic.extras);
 				}
@@ -3270,7 +6756,7 @@ static int cgltf_parse_json_camera(cgltf_options* options, jsmntok_t const* toke
 				}
 			}
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_camera->extras);
 		}
@@ -3318,21 +6804,23 @@ static int cgltf_parse_json_light(cgltf_options* options, jsmntok_t const* token
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "name"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_light->name);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "color") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "color"))
 		{
 			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_light->color, 3);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "intensity") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "intensity"))
 		{
 			++i;
 			out_light->intensity = cgltf_json_to_float(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "type") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "type"))
 		{
 			++i;
 			if (cgltf_json_strcmp(tokens + i, json_chunk, "directional") == 0)
@@ -3349,13 +6837,13 @@ static int cgltf_parse_json_light(cgltf_options* options, jsmntok_t const* token
 			}
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "range") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "range"))
 		{
 			++i;
 			out_light->range = cgltf_json_to_float(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "spot") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "spot"))
 		{
 			++i;
 
@@ -3368,13 +6856,15 @@ static int cgltf_parse_json_light(cgltf_options* options, jsmntok_t const* token
 			{
 				CGLTF_CHECK_KEY(tokens[i]);
 
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "innerConeAngle") == 0)
+				uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+				if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "innerConeAngle"))
 				{
 					++i;
 					out_light->spot_inner_cone_angle = cgltf_json_to_float(tokens + i, json_chunk);
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "outerConeAngle") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "outerConeAngle"))
 				{
 					++i;
 					out_light->spot_outer_cone_angle = cgltf_json_to_float(tokens + i, json_chunk);
@@ -3444,11 +6934,13 @@ static int cgltf_parse_json_node(cgltf_options* options, jsmntok_t const* tokens
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "name"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_node->name);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "children") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "children"))
 		{
 			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_node*), (void**)&out_node->children, &out_node->children_count);
 			if (i < 0)
@@ -3462,48 +6954,48 @@ static int cgltf_parse_json_node(cgltf_options* options, jsmntok_t const* tokens
 				++i;
 			}
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "mesh") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "mesh"))
 		{
 			++i;
 			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
 			out_node->mesh = CGLTF_PTRINDEX(cgltf_mesh, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "skin") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "skin"))
 		{
 			++i;
 			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
 			out_node->skin = CGLTF_PTRINDEX(cgltf_skin, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "camera") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "camera"))
 		{
 			++i;
 			CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
 			out_node->camera = CGLTF_PTRINDEX(cgltf_camera, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "translation") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "translation"))
 		{
 			out_node->has_translation = 1;
 			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_node->translation, 3);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "rotation") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "rotation"))
 		{
 			out_node->has_rotation = 1;
 			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_node->rotation, 4);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "scale") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "scale"))
 		{
 			out_node->has_scale = 1;
 			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_node->scale, 3);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "matrix") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "matrix"))
 		{
 			out_node->has_matrix = 1;
 			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_node->matrix, 16);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "weights") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "weights"))
 		{
 			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_float), (void**)&out_node->weights, &out_node->weights_count);
 			if (i < 0)
@@ -3513,11 +7005,11 @@ static int cgltf_parse_json_node(cgltf_options* options, jsmntok_t const* tokens
 
 			i = cgltf_parse_json_float_array(tokens, i - 1, json_chunk, out_node->weights, (int)out_node->weights_count);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_node->extras);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extensions"))
 		{
 			++i;
 
@@ -3530,7 +7022,9 @@ static int cgltf_parse_json_node(cgltf_options* options, jsmntok_t const* tokens
 			{
 				CGLTF_CHECK_KEY(tokens[i]);
 
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_lights_punctual") == 0)
+				uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+				if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "KHR_lights_punctual"))
 				{
 					++i;
 
@@ -3543,7 +7037,9 @@ static int cgltf_parse_json_node(cgltf_options* options, jsmntok_t const* tokens
 					{
 						CGLTF_CHECK_KEY(tokens[i]);
 
-						if (cgltf_json_strcmp(tokens + i, json_chunk, "light") == 0)
+						uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+						if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "light"))
 						{
 							++i;
 							CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_PRIMITIVE);
@@ -3616,11 +7112,13 @@ static int cgltf_parse_json_scene(cgltf_options* options, jsmntok_t const* token
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "name"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_scene->name);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "nodes") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "nodes"))
 		{
 			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_node*), (void**)&out_scene->nodes, &out_scene->nodes_count);
 			if (i < 0)
@@ -3634,7 +7132,7 @@ static int cgltf_parse_json_scene(cgltf_options* options, jsmntok_t const* token
 				++i;
 			}
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_scene->extras);
 		}
@@ -3683,19 +7181,21 @@ static int cgltf_parse_json_animation_sampler(cgltf_options* options, jsmntok_t
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "input") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "input"))
 		{
 			++i;
 			out_sampler->input = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "output") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "output"))
 		{
 			++i;
 			out_sampler->output = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "interpolation") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "interpolation"))
 		{
 			++i;
 			if (cgltf_json_strcmp(tokens + i, json_chunk, "LINEAR") == 0)
@@ -3712,7 +7212,7 @@ static int cgltf_parse_json_animation_sampler(cgltf_options* options, jsmntok_t
 			}
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_sampler->extras);
 		}
@@ -3742,13 +7242,15 @@ static int cgltf_parse_json_animation_channel(cgltf_options* options, jsmntok_t
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "sampler") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "sampler"))
 		{
 			++i;
 			out_channel->sampler = CGLTF_PTRINDEX(cgltf_animation_sampler, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "target") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "target"))
 		{
 			++i;
 
@@ -3761,13 +7263,15 @@ static int cgltf_parse_json_animation_channel(cgltf_options* options, jsmntok_t
 			{
 				CGLTF_CHECK_KEY(tokens[i]);
 
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "node") == 0)
+				uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+				if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "node"))
 				{
 					++i;
 					out_channel->target_node = CGLTF_PTRINDEX(cgltf_node, cgltf_json_to_int(tokens + i, json_chunk));
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens+i, json_chunk, "path") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "path"))
 				{
 					++i;
 					if (cgltf_json_strcmp(tokens+i, json_chunk, "translation") == 0)
@@ -3788,7 +7292,7 @@ static int cgltf_parse_json_animation_channel(cgltf_options* options, jsmntok_t
 					}
 					++i;
 				}
-				else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+				else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 				{
 					i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_channel->extras);
 				}
@@ -3828,11 +7332,13 @@ static int cgltf_parse_json_animation(cgltf_options* options, jsmntok_t const* t
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "name"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_animation->name);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "samplers") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "samplers"))
 		{
 			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_animation_sampler), (void**)&out_animation->samplers, &out_animation->samplers_count);
 			if (i < 0)
@@ -3849,7 +7355,7 @@ static int cgltf_parse_json_animation(cgltf_options* options, jsmntok_t const* t
 				}
 			}
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "channels") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "channels"))
 		{
 			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_animation_channel), (void**)&out_animation->channels, &out_animation->channels_count);
 			if (i < 0)
@@ -3866,7 +7372,7 @@ static int cgltf_parse_json_animation(cgltf_options* options, jsmntok_t const* t
 				}
 			}
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_animation->extras);
 		}
@@ -3914,23 +7420,25 @@ static int cgltf_parse_json_asset(cgltf_options* options, jsmntok_t const* token
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "copyright") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "copyright"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_asset->copyright);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "generator") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "generator"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_asset->generator);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "version") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "version"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_asset->version);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "minVersion") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "minVersion"))
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_asset->min_version);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_asset->extras);
 		}
@@ -4005,6 +7513,7 @@ static cgltf_size cgltf_calc_size(cgltf_type type, cgltf_component_type componen
 }
 
 static int cgltf_fixup_pointers(cgltf_data* out_data);
+static cgltf_bool cgltf_build_name_index(cgltf_options* options, cgltf_data* data);
 
 static int cgltf_parse_json_root(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
 {
@@ -4017,73 +7526,75 @@ static int cgltf_parse_json_root(cgltf_options* options, jsmntok_t const* tokens
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "asset") == 0)
+		uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+		if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "asset"))
 		{
 			i = cgltf_parse_json_asset(options, tokens, i + 1, json_chunk, &out_data->asset);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "meshes") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "meshes"))
 		{
 			i = cgltf_parse_json_meshes(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "accessors") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "accessors"))
 		{
 			i = cgltf_parse_json_accessors(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "bufferViews") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "bufferViews"))
 		{
 			i = cgltf_parse_json_buffer_views(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "buffers") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "buffers"))
 		{
 			i = cgltf_parse_json_buffers(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "materials") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "materials"))
 		{
 			i = cgltf_parse_json_materials(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "images") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "images"))
 		{
 			i = cgltf_parse_json_images(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "textures") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "textures"))
 		{
 			i = cgltf_parse_json_textures(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "samplers") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "samplers"))
 		{
 			i = cgltf_parse_json_samplers(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "skins") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "skins"))
 		{
 			i = cgltf_parse_json_skins(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "cameras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "cameras"))
 		{
 			i = cgltf_parse_json_cameras(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "nodes") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "nodes"))
 		{
 			i = cgltf_parse_json_nodes(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "scenes") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "scenes"))
 		{
 			i = cgltf_parse_json_scenes(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "scene") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "scene"))
 		{
 			++i;
 			out_data->scene = CGLTF_PTRINDEX(cgltf_scene, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "animations") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "animations"))
 		{
 			i = cgltf_parse_json_animations(options, tokens, i + 1, json_chunk, out_data);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "extras") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extras"))
 		{
 			i = cgltf_parse_json_extras(tokens, i + 1, json_chunk, &out_data->extras);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extensions"))
 		{
 			++i;
 
@@ -4096,7 +7607,9 @@ static int cgltf_parse_json_root(cgltf_options* options, jsmntok_t const* tokens
 			{
 				CGLTF_CHECK_KEY(tokens[i]);
 
-				if (cgltf_json_strcmp(tokens+i, json_chunk, "KHR_lights_punctual") == 0)
+				uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+				if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "KHR_lights_punctual"))
 				{
 					++i;
 
@@ -4109,7 +7622,9 @@ static int cgltf_parse_json_root(cgltf_options* options, jsmntok_t const* tokens
 					{
 						CGLTF_CHECK_KEY(tokens[i]);
 
-						if (cgltf_json_strcmp(tokens + i, json_chunk, "lights") == 0)
+						uint64_t key = cgltf_json_key(tokens + i, json_chunk);
+
+						if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "lights"))
 						{
 							i = cgltf_parse_json_lights(options, tokens, i + 1, json_chunk, out_data);
 						}
@@ -4135,11 +7650,11 @@ static int cgltf_parse_json_root(cgltf_options* options, jsmntok_t const* tokens
 				}
 			}
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensionsUsed") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extensionsUsed"))
 		{
 			i = cgltf_parse_json_string_array(options, tokens, i + 1, json_chunk, &out_data->extensions_used, &out_data->extensions_used_count);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensionsRequired") == 0)
+		else if (CGLTF_JSON_KEY_EQUAL(key, tokens + i, json_chunk, "extensionsRequired"))
 		{
 			i = cgltf_parse_json_string_array(options, tokens, i + 1, json_chunk, &out_data->extensions_required, &out_data->extensions_required_count);
 		}
@@ -4157,37 +7672,72 @@ static int cgltf_parse_json_root(cgltf_options* options, jsmntok_t const* tokens
 	return i;
 }
 
-cgltf_result cgltf_parse_json(cgltf_options* options, const uint8_t* json_chunk, cgltf_size size, cgltf_data** out_data)
+static jsmntok_t* cgltf_tokenize_json(cgltf_options* options, const uint8_t* json_chunk, cgltf_size size, int* out_token_count, cgltf_result* out_result)
 {
-	jsmn_parser parser = { 0, 0, 0 };
-
-	if (options->json_token_count == 0)
-	{
-		int token_count = jsmn_parse(&parser, (const char*)json_chunk, size, NULL, 0);
+	jsmn_parser parser;
+	jsmn_init(&parser);
 
-		if (token_count <= 0)
-		{
-			return cgltf_result_invalid_json;
-		}
+	cgltf_size capacity = options->json_token_count;
+	cgltf_bool growable = capacity == 0;
 
-		options->json_token_count = token_count;
+	if (growable)
+	{
+		// Start from a conservative estimate and grow geometrically, resuming the parser
+		// where it stopped; this avoids a separate counting pass over the whole document
+		capacity = size / 16 + 64;
 	}
 
-	jsmntok_t* tokens = (jsmntok_t*)options->memory_alloc(options->memory_user_data, sizeof(jsmntok_t) * (options->json_token_count + 1));
+	jsmntok_t* tokens = (jsmntok_t*)options->memory_alloc(options->memory_user_data, sizeof(jsmntok_t) * (capacity + 1));
 
 	if (!tokens)
 	{
-		return cgltf_result_out_of_memory;
+		*out_result = cgltf_result_out_of_memory;
+		return NULL;
 	}
 
-	jsmn_init(&parser);
+	int token_count = jsmn_parse(&parser, (const char*)json_chunk, size, tokens, capacity);
+
+	while (token_count == JSMN_ERROR_NOMEM && growable)
+	{
+		cgltf_size new_capacity = capacity * 2;
+		jsmntok_t* new_tokens = (jsmntok_t*)options->memory_alloc(options->memory_user_data, sizeof(jsmntok_t) * (new_capacity + 1));
 
-	int token_count = jsmn_parse(&parser, (const char*)json_chunk, size, tokens, options->json_token_count);
+		if (!new_tokens)
+		{
+			options->memory_free(options->memory_user_data, tokens);
+			*out_result = cgltf_result_out_of_memory;
+			return NULL;
+		}
+
+		memcpy(new_tokens, tokens, sizeof(jsmntok_t) * parser.toknext);
+		options->memory_free(options->memory_user_data, tokens);
+
+		tokens = new_tokens;
+		capacity = new_capacity;
+
+		token_count = jsmn_parse(&parser, (const char*)json_chunk, size, tokens, capacity);
+	}
 
 	if (token_count <= 0)
 	{
 		options->memory_free(options->memory_user_data, tokens);
-		return cgltf_result_invalid_json;
+		*out_result = cgltf_result_invalid_json;
+		return NULL;
+	}
+
+	*out_token_count = token_count;
+	return tokens;
+}
+
+cgltf_result cgltf_parse_json(cgltf_options* options, const uint8_t* json_chunk, cgltf_size size, cgltf_data** out_data)
+{
+	int token_count = 0;
+	cgltf_result tokenize_result = cgltf_result_success;
+	jsmntok_t* tokens = cgltf_tokenize_json(options, json_chunk, size, &token_count, &tokenize_result);
+
+	if (!tokens)
+	{
+		return tokenize_result;
 	}
 
 	// this makes sure that we always have an UNDEFINED token at the end of the stream
@@ -4203,10 +7753,37 @@ cgltf_result cgltf_parse_json(cgltf_options* options, const uint8_t* json_chunk,
 	}
 
 	memset(data, 0, sizeof(cgltf_data));
+	data->memory_alloc = options->memory_alloc;
 	data->memory_free = options->memory_free;
 	data->memory_user_data = options->memory_user_data;
+	data->json_token_count = token_count;
+	data->in_place_strings = options->in_place_strings;
+
+	int i;
+
+	if (options->arena)
+	{
+		// The first block fits all strings plus a generous estimate of the object arrays;
+		// larger documents only spill into a few more blocks
+		cgltf_arena arena;
+		arena.blocks = NULL;
+		arena.block_size = size + token_count * 16;
+		arena.memory_alloc = options->memory_alloc;
+		arena.memory_user_data = options->memory_user_data;
+
+		cgltf_options arena_options = *options;
+		arena_options.memory_alloc = &cgltf_arena_alloc;
+		arena_options.memory_free = &cgltf_arena_free;
+		arena_options.memory_user_data = &arena;
 
-	int i = cgltf_parse_json_root(options, tokens, 0, json_chunk, data);
+		i = cgltf_parse_json_root(&arena_options, tokens, 0, json_chunk, data);
+
+		data->arena = arena.blocks;
+	}
+	else
+	{
+		i = cgltf_parse_json_root(options, tokens, 0, json_chunk, data);
+	}
 
 	options->memory_free(options->memory_user_data, tokens);
 
@@ -4222,6 +7799,12 @@ cgltf_result cgltf_parse_json(cgltf_options* options, const uint8_t* json_chunk,
 		return cgltf_result_invalid_gltf;
 	}
 
+	if (options->name_index && !cgltf_build_name_index(options, data))
+	{
+		cgltf_free(data);
+		return cgltf_result_out_of_memory;
+	}
+
 	data->json = (const char*)json_chunk;
 	data->json_size = size;
 
@@ -22,7 +22,28 @@
  * cgltf_size size, const cgltf_data* data)` writes JSON into the given memory
  * buffer. Returns the number of bytes written to `buffer`, including a null
  * terminator. If buffer is null, returns the number of bytes that would have
- * been written. `data` is not deallocated.
+ * been written. `data` is not deallocated. Floats are written with the fewest
+ * digits that parse back to the same value, independent of the C locale.
+ *
+ * `cgltf_result cgltf_write_stream(const cgltf_options* options, cgltf_size
+ * (*write)(void* user, const void* data, cgltf_size size), void* user, const
+ * cgltf_data* data)` writes JSON in a single pass, passing it to `write` in
+ * chunks of up to 64 KB (more for single values that don't fit). `write` must
+ * return the number of bytes it consumed; if it consumes fewer, the result is
+ * `cgltf_result_io_error`, while a buffer that cannot grow gives
+ * `cgltf_result_out_of_memory`. `cgltf_write_file` uses it to write to the
+ * file directly.
+ *
+ * `cgltf_result cgltf_write_glb(const cgltf_options* options, cgltf_size
+ * (*write)(void* user, const void* data, cgltf_size size), void* user, const
+ * cgltf_data* data)` writes a binary glTF by passing consecutive pieces of it to
+ * `write`, which must return the number of bytes it consumed. The JSON chunk is
+ * padded with spaces to a multiple of 4 bytes. The data of the first buffer
+ * becomes the BIN chunk, padded with zeros, and its "uri" is omitted; it is
+ * passed to `write` directly, without being copied. Other buffers keep their
+ * URIs. The first buffer must have its data loaded, and the whole file must
+ * be smaller than 4 GB. `cgltf_write_glb_file` does the same for the given file
+ * path. `data` is not deallocated.
  */
 #ifndef CGLTF_WRITE_H_INCLUDED__
 #define CGLTF_WRITE_H_INCLUDED__
@@ -38,6 +59,9 @@ extern "C" {
 
 cgltf_result cgltf_write_file(const cgltf_options* options, const char* path, const cgltf_data* data);
 cgltf_size cgltf_write(const cgltf_options* options, char* buffer, cgltf_size size, const cgltf_data* data);
+cgltf_result cgltf_write_stream(const cgltf_options* options, cgltf_size (*write)(void* user, const void* data, cgltf_size size), void* user, const cgltf_data* data);
+cgltf_result cgltf_write_glb_file(const cgltf_options* options, const char* path, const cgltf_data* data);
+cgltf_result cgltf_write_glb(const cgltf_options* options, cgltf_size (*write)(void* user, const void* data, cgltf_size size), void* user, const cgltf_data* data);
 
 #ifdef __cplusplus
 }
@@ -77,14 +101,28 @@ typedef struct {
 	size_t tmp;
 	size_t chars_written;
 	const cgltf_data* data;
+	const cgltf_buffer* bin;
 	int depth;
 	const char* indent;
 	int needs_comma;
 	uint32_t extension_flags;
+	bool growable;
+	cgltf_result result; /* first failure of a growable context, out_of_memory or io_error from the sink */
+	cgltf_size (*sink)(void* user, const void* data, cgltf_size size);
+	void* sink_user;
 } cgltf_write_context;
 
+#ifndef CGLTF_WRITE_CHUNK_SIZE
+#define CGLTF_WRITE_CHUNK_SIZE 65536
+#endif
+
+static bool cgltf_write_reserve(cgltf_write_context* context, size_t size);
+
 #define CGLTF_SPRINTF(fmt, ...) { \
 		context->tmp = snprintf ( context->cursor, context->remaining, fmt, ## __VA_ARGS__ ); \
+		if (context->growable && context->tmp >= context->remaining && cgltf_write_reserve(context, context->tmp + 1)) { \
+			context->tmp = snprintf ( context->cursor, context->remaining, fmt, ## __VA_ARGS__ ); \
+		} \
 		context->chars_written += context->tmp; \
 		if (context->cursor) { \
 			context->cursor += context->tmp; \
@@ -118,6 +156,392 @@ typedef struct {
 		} \
 		cgltf_write_line(context, "}"); }
 
+// Makes room for at least `size` bytes after the cursor of a growable context, by passing what has been
+// written so far to the sink if there is one, and by growing the buffer otherwise or if that's not enough.
+static bool cgltf_write_reserve(cgltf_write_context* context, size_t size)
+{
+	size_t used = context->cursor - context->buffer;
+
+	if (context->sink && used > 0)
+	{
+		if (context->sink(context->sink_user, context->buffer, used) != used && context->result == cgltf_result_success)
+		{
+			context->result = cgltf_result_io_error;
+		}
+		used = 0;
+		context->cursor = context->buffer;
+		context->remaining = context->buffer_size;
+	}
+
+	if (size <= context->remaining)
+	{
+		return true;
+	}
+
+	size_t buffer_size = context->buffer_size * 2 > used + size ? context->buffer_size * 2 : used + size;
+	char* buffer = (char*) realloc(context->buffer, buffer_size);
+	if (!buffer)
+	{
+		// Keep counting the output, but stop writing it.
+		free(context->buffer);
+		context->result = context->result == cgltf_result_success ? cgltf_result_out_of_memory : context->result;
+		context->growable = false;
+		context->buffer = NULL;
+		context->cursor = NULL;
+		context->remaining = 0;
+		return false;
+	}
+
+	context->buffer = buffer;
+	context->buffer_size = buffer_size;
+	context->cursor = buffer + used;
+	context->remaining = buffer_size - used;
+	return true;
+}
+
+// Shortest round-trip formatting of floats, following the Ryu algorithm by Ulf Adams
+// (https://github.com/ulfjack/ryu, Apache 2.0 / Boost licensed): among the decimals that
+// parse back to the same float, pick the one with the fewest digits, closest to the value.
+#define CGLTF_FLOAT_POW5_INV_BITCOUNT 59
+#define CGLTF_FLOAT_POW5_BITCOUNT 61
+
+static const uint64_t cgltf_float_pow5_inv_split[31] = {
+	576460752303423489ull, 461168601842738791ull, 368934881474191033ull,
+	295147905179352826ull, 472236648286964522ull, 377789318629571618ull,
+	302231454903657294ull, 483570327845851670ull, 386856262276681336ull,
+	309485009821345069ull, 495176015714152110ull, 396140812571321688ull,
+	316912650057057351ull, 507060240091291761ull, 405648192073033409ull,
+	324518553658426727ull, 519229685853482763ull, 415383748682786211ull,
+	332306998946228969ull, 531691198313966350ull, 425352958651173080ull,
+	340282366920938464ull, 544451787073501542ull, 435561429658801234ull,
+	348449143727040987ull, 557518629963265579ull, 446014903970612463ull,
+	356811923176489971ull, 570899077082383953ull, 456719261665907162ull,
+	365375409332725730ull
+};
+
+static const uint64_t cgltf_float_pow5_split[47] = {
+	1152921504606846976ull, 1441151880758558720ull, 1801439850948198400ull,
+	2251799813685248000ull, 1407374883553280000ull, 1759218604441600000ull,
+	2199023255552000000ull, 1374389534720000000ull, 1717986918400000000ull,
+	2147483648000000000ull, 1342177280000000000ull, 1677721600000000000ull,
+	2097152000000000000ull, 1310720000000000000ull, 1638400000000000000ull,
+	2048000000000000000ull, 1280000000000000000ull, 1600000000000000000ull,
+	2000000000000000000ull, 1250000000000000000ull, 1562500000000000000ull,
+	1953125000000000000ull, 1220703125000000000ull, 1525878906250000000ull,
+	1907348632812500000ull, 1192092895507812500ull, 1490116119384765625ull,
+	1862645149230957031ull, 1164153218269348144ull, 1455191522836685180ull,
+	1818989403545856475ull, 2273736754432320594ull, 1421085471520200371ull,
+	1776356839400250464ull, 2220446049250313080ull, 1387778780781445675ull,
+	1734723475976807094ull, 2168404344971008868ull, 1355252715606880542ull,
+	1694065894508600678ull, 2117582368135750847ull, 1323488980084844279ull,
+	1654361225106055349ull, 2067951531382569187ull, 1292469707114105741ull,
+	1615587133892632177ull, 2019483917365790221ull
+};
+
+static uint32_t cgltf_pow5bits(int32_t e)
+{
+	// ceil(log2(5^e)) for e > 0, and 1 for e == 0
+	return (uint32_t) (((uint32_t) e * 1217359) >> 19) + 1;
+}
+
+static uint32_t cgltf_log10_pow2(int32_t e)
+{
+	return ((uint32_t) e * 78913) >> 18;
+}
+
+static uint32_t cgltf_log10_pow5(int32_t e)
+{
+	return ((uint32_t) e * 732923) >> 20;
+}
+
+static bool cgltf_multiple_of_pow5(uint32_t value, uint32_t p)
+{
+	uint32_t count = 0;
+	while (value % 5 == 0 && value != 0)
+	{
+		value /= 5;
+		++count;
+	}
+	return count >= p;
+}
+
+static uint32_t cgltf_mul_shift32(uint32_t m, uint64_t factor, int32_t shift)
+{
+	uint64_t bits0 = (uint64_t) m * (uint32_t) factor;
+	uint64_t bits1 = (uint64_t) m * (uint32_t) (factor >> 32);
+	uint64_t sum = (bits0 >> 32) + bits1;
+	return (uint32_t) (sum >> (shift - 32));
+}
+
+// Computes the shortest decimal digits * 10^exponent that rounds to the finite, non-zero float with the given bits.
+static void cgltf_float_to_decimal(uint32_t bits, uint32_t* out_digits, int32_t* out_exponent)
+{
+	uint32_t ieee_mantissa = bits & ((1u << 23) - 1);
+	uint32_t ieee_exponent = (bits >> 23) & 0xff;
+
+	int32_t e2;
+	uint32_t m2;
+	if (ieee_exponent == 0)
+	{
+		e2 = 1 - 127 - 23 - 2;
+		m2 = ieee_mantissa;
+	}
+	else
+	{
+		e2 = (int32_t) ieee_exponent - 127 - 23 - 2;
+		m2 = (1u << 23) | ieee_mantissa;
+	}
+
+	// The interval of reals that round to the float is [mm, mp] * 2^e2, inclusive if the mantissa is even.
+	bool accept_bounds = (m2 & 1) == 0;
+	uint32_t mv = 4 * m2;
+	uint32_t mp = 4 * m2 + 2;
+	uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+	uint32_t mm = 4 * m2 - 1 - mm_shift;
+
+	uint32_t vr, vp, vm;
+	int32_t e10;
+	bool vm_is_trailing_zeros = false;
+	bool vr_is_trailing_zeros = false;
+	uint8_t last_removed_digit = 0;
+
+	if (e2 >= 0)
+	{
+		uint32_t q = cgltf_log10_pow2(e2);
+		e10 = (int32_t) q;
+		int32_t k = CGLTF_FLOAT_POW5_INV_BITCOUNT + cgltf_pow5bits(q) - 1;
+		int32_t i = -e2 + (int32_t) q + k;
+		vr = cgltf_mul_shift32(mv, cgltf_float_pow5_inv_split[q], i);
+		vp = cgltf_mul_shift32(mp, cgltf_float_pow5_inv_split[q], i);
+		vm = cgltf_mul_shift32(mm, cgltf_float_pow5_inv_split[q], i);
+		if (q != 0 && (vp - 1) / 10 <= vm / 10)
+		{
+			int32_t l = CGLTF_FLOAT_POW5_INV_BITCOUNT + cgltf_pow5bits(q - 1) - 1;
+			last_removed_digit = (uint8_t) (cgltf_mul_shift32(mv, cgltf_float_pow5_inv_split[q - 1], -e2 + (int32_t) q - 1 + l) % 10);
+		}
+		if (q <= 9)
+		{
+			if (mv % 5 == 0)
+			{
+				vr_is_trailing_zeros = cgltf_multiple_of_pow5(mv, q);
+			}
+			else if (accept_bounds)
+			{
+				vm_is_trailing_zeros = cgltf_multiple_of_pow5(mm, q);
+			}
+			else
+			{
+				vp -= cgltf_multiple_of_pow5(mp, q);
+			}
+		}
+	}
+	else
+	{
+		uint32_t q = cgltf_log10_pow5(-e2);
+		e10 = (int32_t) q + e2;
+		int32_t i = -e2 - (int32_t) q;
+		int32_t k = (int32_t) cgltf_pow5bits(i) - CGLTF_FLOAT_POW5_BITCOUNT;
+		int32_t j = (int32_t) q - k;
+		vr = cgltf_mul_shift32(mv, cgltf_float_pow5_split[i], j);
+		vp = cgltf_mul_shift32(mp, cgltf_float_pow5_split[i], j);
+		vm = cgltf_mul_shift32(mm, cgltf_float_pow5_split[i], j);
+		if (q != 0 && (vp - 1) / 10 <= vm / 10)
+		{
+			j = (int32_t) q - 1 - ((int32_t) cgltf_pow5bits(i + 1) - CGLTF_FLOAT_POW5_BITCOUNT);
+			last_removed_digit = (uint8_t) (cgltf_mul_shift32(mv, cgltf_float_pow5_split[i + 1], j) % 10);
+		}
+		if (q <= 1)
+		{
+			vr_is_trailing_zeros = true;
+			if (accept_bounds)
+			{
+				vm_is_trailing_zeros = mm_shift == 1;
+			}
+			else
+			{
+				--vp;
+			}
+		}
+		else if (q < 31)
+		{
+			vr_is_trailing_zeros = (mv & ((1u << (q - 1)) - 1)) == 0;
+		}
+	}
+
+	// Remove digits while the interval still contains a shorter decimal.
+	int32_t removed = 0;
+	uint32_t output;
+	if (vm_is_trailing_zeros || vr_is_trailing_zeros)
+	{
+		while (vp / 10 > vm / 10)
+		{
+			vm_is_trailing_zeros &= vm % 10 == 0;
+			vr_is_trailing_zeros &= last_removed_digit == 0;
+			last_removed_digit = (uint8_t) (vr % 10);
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			++removed;
+		}
+		if (vm_is_trailing_zeros)
+		{
+			while (vm % 10 == 0)
+			{
+				vr_is_trailing_zeros &= last_removed_digit == 0;
+				last_removed_digit = (uint8_t) (vr % 10);
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				++removed;
+			}
+		}
+		if (vr_is_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0)
+		{
+			// Round half to even.
+			last_removed_digit = 4;
+		}
+		output = vr + ((vr == vm && (!accept_bounds || !vm_is_trailing_zeros)) || last_removed_digit >= 5);
+	}
+	else
+	{
+		while (vp / 10 > vm / 10)
+		{
+			last_removed_digit = (uint8_t) (vr % 10);
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			++removed;
+		}
+		output = vr + (vr == vm || last_removed_digit >= 5);
+	}
+
+	*out_digits = output;
+	*out_exponent = e10 + removed;
+}
+
+// Writes the shortest representation of val that parses back to the same float, using a '.' decimal
+// point regardless of the locale. The output needs at most 16 bytes including the null terminator.
+static int cgltf_format_float(char* out, float val)
+{
+	uint32_t bits;
+	memcpy(&bits, &val, sizeof(bits));
+
+	char* cursor = out;
+	if (bits >> 31)
+	{
+		*cursor++ = '-';
+	}
+
+	if (((bits >> 23) & 0xff) == 0xff)
+	{
+		// JSON has no representation for these, so write what printf("%g") would.
+		const char* special = (bits & ((1u << 23) - 1)) ? "nan" : "inf";
+		memcpy(cursor, special, 4);
+		return (int) (cursor - out) + 3;
+	}
+
+	if ((bits & 0x7fffffff) == 0)
+	{
+		cursor[0] = '0';
+		cursor[1] = 0;
+		return (int) (cursor - out) + 1;
+	}
+
+	uint32_t digits;
+	int32_t exponent;
+	cgltf_float_to_decimal(bits, &digits, &exponent);
+
+	char buffer[10];
+	int length = 0;
+	while (digits)
+	{
+		buffer[9 - length++] = (char) ('0' + digits % 10);
+		digits /= 10;
+	}
+	const char* first = buffer + 10 - length;
+
+	// The decimal exponent of the first digit selects between plain and scientific notation.
+	int32_t point = exponent + length;
+	if (point > -4 && point <= 9)
+	{
+		if (point <= 0)
+		{
+			*cursor++ = '0';
+			*cursor++ = '.';
+			for (int32_t i = point; i < 0; ++i)
+			{
+				*cursor++ = '0';
+			}
+			memcpy(cursor, first, length);
+			cursor += length;
+		}
+		else if (point >= length)
+		{
+			memcpy(cursor, first, length);
+			cursor += length;
+			for (int32_t i = length; i < point; ++i)
+			{
+				*cursor++ = '0';
+			}
+		}
+		else
+		{
+			memcpy(cursor, first, point);
+			cursor += point;
+			*cursor++ = '.';
+			memcpy(cursor, first + point, length - point);
+			cursor += length - point;
+		}
+	}
+	else
+	{
+		*cursor++ = first[0];
+		if (length > 1)
+		{
+			*cursor++ = '.';
+			memcpy(cursor, first + 1, length - 1);
+			cursor += length - 1;
+		}
+		int32_t e = point - 1;
+		*cursor++ = 'e';
+		if (e < 0)
+		{
+			*cursor++ = '-';
+			e = -e;
+		}
+		if (e >= 10)
+		{
+			*cursor++ = (char) ('0' + e / 10);
+		}
+		*cursor++ = (char) ('0' + e % 10);
+	}
+
+	*cursor = 0;
+	return (int) (cursor - out);
+}
+
+// Appends characters like CGLTF_SPRINTF("%s", str) would, without going through snprintf.
+static void cgltf_write_chars(cgltf_write_context* context, const char* str, size_t length)
+{
+	if (context->growable && length >= context->remaining)
+	{
+		cgltf_write_reserve(context, length + 1);
+	}
+	context->tmp = length;
+	context->chars_written += length;
+	if (context->cursor)
+	{
+		if (context->remaining > 0)
+		{
+			size_t copied = length < context->remaining ? length : context->remaining - 1;
+			memcpy(context->cursor, str, copied);
+			context->cursor[copied] = 0;
+		}
+		context->cursor += length;
+		context->remaining -= length;
+	}
+}
+
 static void cgltf_write_indent(cgltf_write_context* context)
 {
 	if (context->needs_comma)
@@ -187,19 +611,12 @@ static void cgltf_write_floatprop(cgltf_write_context* context, const char* labe
 {
 	if (val != def)
 	{
+		char str[16];
+		int length = cgltf_format_float(str, val);
 		cgltf_write_indent(context);
 		CGLTF_SPRINTF("\"%s\": ", label);
-		CGLTF_SPRINTF("%g", val);
+		cgltf_write_chars(context, str, length);
 		context->needs_comma = 1;
-
-		if (context->cursor)
-		{
-			char *decimal_comma = strchr(context->cursor - context->tmp, ',');
-			if (decimal_comma)
-			{
-				*decimal_comma = '.';
-			}
-		}
 	}
 }
 
@@ -219,13 +636,16 @@ static void cgltf_write_floatarrayprop(cgltf_write_context* context, const char*
 	CGLTF_SPRINTF("\"%s\": [", label);
 	for (int i = 0; i < dim; ++i)
 	{
+		// Leave room for the separator in front of the number.
+		char str[18] = { ',', ' ' };
+		int length = cgltf_format_float(str + 2, vals[i]);
 		if (i != 0)
 		{
-			CGLTF_SPRINTF(", %g", vals[i]);
+			cgltf_write_chars(context, str, length + 2);
 		}
 		else
 		{
-			CGLTF_SPRINTF("%g", vals[i]);
+			cgltf_write_chars(context, str + 2, length);
 		}
 	}
 	CGLTF_SPRINTF("]");
@@ -413,7 +833,7 @@ static void cgltf_write_buffer_view(cgltf_write_context* context, const cgltf_bu
 static void cgltf_write_buffer(cgltf_write_context* context, const cgltf_buffer* buffer)
 {
 	cgltf_write_line(context, "{");
-	cgltf_write_strprop(context, "uri", buffer->uri);
+	cgltf_write_strprop(context, "uri", buffer == context->bin ? NULL : buffer->uri);
 	cgltf_write_intprop(context, "byteLength", buffer->size, -1);
 	cgltf_write_line(context, "}");
 }
@@ -765,41 +1185,28 @@ static void cgltf_write_light(cgltf_write_context* context, const cgltf_light* l
 	cgltf_write_line(context, "}");
 }
 
-cgltf_result cgltf_write_file(const cgltf_options* options, const char* path, const cgltf_data* data)
+static void cgltf_write_init_context(cgltf_write_context* ctx, char* buffer, cgltf_size size, const cgltf_data* data, const cgltf_buffer* bin)
 {
-	size_t expected = cgltf_write(options, NULL, 0, data);
-	char* buffer = (char*) malloc(expected);
-	size_t actual = cgltf_write(options, buffer, expected, data);
-	if (expected != actual) {
-		fprintf(stderr, "Error: expected %zu bytes but wrote %zu bytes.\n", expected, actual);
-	}
-	FILE* file = fopen(path, "wt");
-	if (!file)
-	{
-		return cgltf_result_file_not_found;
-	}
-	// Note that cgltf_write() includes a null terminator, which we omit from the file content.
-	fwrite(buffer, actual - 1, 1, file);
-	fclose(file);
-	free(buffer);
-	return cgltf_result_success;
+	ctx->buffer = buffer;
+	ctx->buffer_size = size;
+	ctx->remaining = size;
+	ctx->cursor = buffer;
+	ctx->chars_written = 0;
+	ctx->data = data;
+	ctx->bin = bin;
+	ctx->depth = 1;
+	ctx->indent = "  ";
+	ctx->needs_comma = 0;
+	ctx->extension_flags = 0;
+	ctx->growable = false;
+	ctx->result = cgltf_result_success;
+	ctx->sink = NULL;
+	ctx->sink_user = NULL;
 }
 
-cgltf_size cgltf_write(const cgltf_options* options, char* buffer, cgltf_size size, const cgltf_data* data)
+static void cgltf_write_document(cgltf_write_context* context)
 {
-	cgltf_write_context ctx;
-	ctx.buffer = buffer;
-	ctx.buffer_size = size;
-	ctx.remaining = size;
-	ctx.cursor = buffer;
-	ctx.chars_written = 0;
-	ctx.data = data;
-	ctx.depth = 1;
-	ctx.indent = "  ";
-	ctx.needs_comma = 0;
-	ctx.extension_flags = 0;
-
-	cgltf_write_context* context = &ctx;
+	const cgltf_data* data = context->data;
 
 	CGLTF_SPRINTF("{");
 
@@ -974,12 +1381,179 @@ cgltf_size cgltf_write(const cgltf_options* options, char* buffer, cgltf_size si
 	}
 
 	CGLTF_SPRINTF("\n}\n");
+}
+
+cgltf_size cgltf_write(const cgltf_options* options, char* buffer, cgltf_size size, const cgltf_data* data)
+{
+	(void) options;
+
+	cgltf_write_context ctx;
+	cgltf_write_init_context(&ctx, buffer, size, data, NULL);
+	cgltf_write_document(&ctx);
 
 	// snprintf does not include the null terminator in its return value, so be sure to include it
 	// in the returned byte count.
 	return 1 + ctx.chars_written;
 }
 
+// Writes the JSON in a single pass, into a buffer that grows geometrically or, with a sink, is passed
+// to the sink in chunks. Sets *out_json to the buffer, which the caller frees; returns out_of_memory if
+// the buffer could not grow and io_error if the sink failed.
+static cgltf_result cgltf_write_json_growable(const cgltf_data* data, const cgltf_buffer* bin, cgltf_size (*sink)(void* user, const void* data, cgltf_size size), void* sink_user, char** out_json, size_t* out_size)
+{
+	char* buffer = (char*) malloc(CGLTF_WRITE_CHUNK_SIZE);
+	if (!buffer)
+	{
+		return cgltf_result_out_of_memory;
+	}
+
+	cgltf_write_context ctx;
+	cgltf_write_init_context(&ctx, buffer, CGLTF_WRITE_CHUNK_SIZE, data, bin);
+	ctx.growable = true;
+	ctx.sink = sink;
+	ctx.sink_user = sink_user;
+	cgltf_write_document(&ctx);
+
+	size_t used = ctx.cursor ? (size_t) (ctx.cursor - ctx.buffer) : 0;
+	if (ctx.result == cgltf_result_success && sink && used > 0 && sink(sink_user, ctx.buffer, used) != used)
+	{
+		ctx.result = cgltf_result_io_error;
+	}
+
+	if (ctx.result != cgltf_result_success)
+	{
+		free(ctx.buffer);
+		return ctx.result;
+	}
+
+	*out_json = ctx.buffer;
+	*out_size = used;
+	return cgltf_result_success;
+}
+
+static cgltf_size cgltf_write_fwrite(void* user, const void* data, cgltf_size size)
+{
+	return fwrite(data, 1, size, (FILE*) user);
+}
+
+cgltf_result cgltf_write_file(const cgltf_options* options, const char* path, const cgltf_data* data)
+{
+	FILE* file = fopen(path, "wt");
+	if (!file)
+	{
+		return cgltf_result_file_not_found;
+	}
+	cgltf_result result = cgltf_write_stream(options, &cgltf_write_fwrite, file, data);
+	if (fclose(file) != 0 && result == cgltf_result_success)
+	{
+		result = cgltf_result_io_error;
+	}
+	return result;
+}
+
+cgltf_result cgltf_write_stream(const cgltf_options* options, cgltf_size (*write)(void* user, const void* data, cgltf_size size), void* user, const cgltf_data* data)
+{
+	(void) options;
+
+	char* buffer = NULL;
+	size_t size = 0;
+	cgltf_result result = cgltf_write_json_growable(data, NULL, write, user, &buffer, &size);
+	if (result != cgltf_result_success)
+	{
+		return result;
+	}
+
+	free(buffer);
+	return cgltf_result_success;
+}
+
+static void cgltf_write_glb_u32(uint8_t* out, cgltf_size value)
+{
+	out[0] = (uint8_t) (value);
+	out[1] = (uint8_t) (value >> 8);
+	out[2] = (uint8_t) (value >> 16);
+	out[3] = (uint8_t) (value >> 24);
+}
+
+static bool cgltf_write_glb_bytes(cgltf_size (*write)(void* user, const void* data, cgltf_size size), void* user, const void* data, cgltf_size size)
+{
+	return size == 0 || write(user, data, size) == size;
+}
+
+cgltf_result cgltf_write_glb_file(const cgltf_options* options, const char* path, const cgltf_data* data)
+{
+	FILE* file = fopen(path, "wb");
+	if (!file)
+	{
+		return cgltf_result_file_not_found;
+	}
+	cgltf_result result = cgltf_write_glb(options, &cgltf_write_fwrite, file, data);
+	if (fclose(file) != 0 && result == cgltf_result_success)
+	{
+		result = cgltf_result_io_error;
+	}
+	return result;
+}
+
+cgltf_result cgltf_write_glb(const cgltf_options* options, cgltf_size (*write)(void* user, const void* data, cgltf_size size), void* user, const cgltf_data* data)
+{
+	(void) options;
+
+	static const uint8_t padding[3] = { 0, 0, 0 };
+	static const char json_padding[3] = { ' ', ' ', ' ' };
+
+	const cgltf_buffer* bin = data->buffers_count > 0 ? data->buffers : NULL;
+	if (bin && bin->size > 0 && !bin->data)
+	{
+		return cgltf_result_invalid_options;
+	}
+
+	// The JSON chunk is small next to the binary data, so it is formatted in memory to know its size up front.
+	char* json = NULL;
+	size_t json_size = 0;
+	cgltf_result result = cgltf_write_json_growable(data, bin, NULL, NULL, &json, &json_size);
+	if (result != cgltf_result_success)
+	{
+		return result;
+	}
+
+	cgltf_size json_chunk_size = (json_size + 3) & ~(cgltf_size) 3;
+	cgltf_size bin_size = bin ? bin->size : 0;
+	cgltf_size bin_chunk_size = (bin_size + 3) & ~(cgltf_size) 3;
+	cgltf_size total_size = 12 + 8 + json_chunk_size + (bin ? 8 + bin_chunk_size : 0);
+
+	if (bin_size > 0xffffffffu || total_size > 0xffffffffu)
+	{
+		free(json);
+		return cgltf_result_invalid_gltf;
+	}
+
+	uint8_t header[20];
+	cgltf_write_glb_u32(header + 0, 0x46546C67); // "glTF"
+	cgltf_write_glb_u32(header + 4, 2);
+	cgltf_write_glb_u32(header + 8, total_size);
+	cgltf_write_glb_u32(header + 12, json_chunk_size);
+	cgltf_write_glb_u32(header + 16, 0x4E4F534A); // "JSON"
+
+	bool ok = cgltf_write_glb_bytes(write, user, header, 20) &&
+		cgltf_write_glb_bytes(write, user, json, json_size) &&
+		cgltf_write_glb_bytes(write, user, json_padding, json_chunk_size - json_size);
+
+	free(json);
+
+	if (ok && bin)
+	{
+		cgltf_write_glb_u32(header + 0, bin_chunk_size);
+		cgltf_write_glb_u32(header + 4, 0x004E4942); // "BIN"
+
+		ok = cgltf_write_glb_bytes(write, user, header, 8) &&
+			cgltf_write_glb_bytes(write, user, bin->data, bin_size) &&
+			cgltf_write_glb_bytes(write, user, padding, bin_chunk_size - bin_size);
+	}
+
+	return ok ? cgltf_result_success : cgltf_result_io_error;
+}
+
 #endif /* #ifdef CGLTF_WRITE_IMPLEMENTATION */
 
 /* cgltf is distributed under MIT license:
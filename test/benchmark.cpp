@@ -0,0 +1,1289 @@
+#define CGLTF_IMPLEMENTATION
+#define CGLTF_WRITE_IMPLEMENTATION
+#define CGLTF_PTHREADS
+#include "../cgltf_write.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::high_resolution_clock bench_clock;
+
+static double seconds_since(bench_clock::time_point start)
+{
+	return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+static bool bench_enabled(int argc, char** argv, const char* name)
+{
+	if (argc < 2)
+	{
+		return true;
+	}
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], name) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static const char* simd_name()
+{
+#if defined(CGLTF_AVX2)
+	return "avx2";
+#elif defined(CGLTF_SSSE3)
+	return "ssse3";
+#elif defined(CGLTF_SSE2)
+	return "sse2";
+#elif defined(CGLTF_NEON)
+	return "neon";
+#else
+	return "scalar";
+#endif
+}
+
+// Measures cgltf_accessor_unpack_floats against per-element cgltf_accessor_read_float for 8- and
+// 16-bit formats, and verifies that both produce identical results.
+static int bench_dequantize()
+{
+	const cgltf_size count = 1 << 20;
+	const int iterations = 10;
+
+	std::vector<uint8_t> data(count * 8);
+	for (cgltf_size i = 0; i < data.size(); ++i)
+	{
+		data[i] = (uint8_t)(i * 2654435761u >> 13);
+	}
+
+	cgltf_buffer buffer = {};
+	buffer.size = data.size();
+	buffer.data = data.data();
+
+	cgltf_buffer_view view = {};
+	view.buffer = &buffer;
+	view.size = data.size();
+
+	struct
+	{
+		const char* name;
+		cgltf_component_type component_type;
+		cgltf_size component_size;
+	} formats[] = {
+		{ "i8", cgltf_component_type_r_8, 1 },
+		{ "u8", cgltf_component_type_r_8u, 1 },
+		{ "i16", cgltf_component_type_r_16, 2 },
+		{ "u16", cgltf_component_type_r_16u, 2 },
+	};
+
+	std::vector<cgltf_float> out(count * 4);
+	std::vector<cgltf_float> reference(count * 4);
+
+	printf("dequantize (%s, %d elements)\n", simd_name(), (int)count);
+
+	for (const auto& format : formats)
+	{
+		for (int normalized = 0; normalized < 2; ++normalized)
+		{
+			for (int padded = 0; padded < 2; ++padded)
+			{
+				cgltf_accessor accessor = {};
+				accessor.component_type = format.component_type;
+				accessor.normalized = normalized;
+				accessor.type = padded ? cgltf_type_vec3 : cgltf_type_vec4;
+				accessor.count = count;
+				accessor.stride = format.component_size * 4;
+				accessor.buffer_view = &view;
+
+				cgltf_size float_count = cgltf_accessor_unpack_floats(&accessor, NULL, 0);
+
+				bench_clock::time_point start = bench_clock::now();
+				for (int it = 0; it < iterations; ++it)
+				{
+					cgltf_accessor_unpack_floats(&accessor, out.data(), float_count);
+				}
+				double bulk = seconds_since(start) / iterations;
+
+				cgltf_size num_components = float_count / count;
+				start = bench_clock::now();
+				for (cgltf_size i = 0; i < count; ++i)
+				{
+					cgltf_accessor_read_float(&accessor, i, &reference[i * num_components], num_components);
+				}
+				double single = seconds_since(start);
+
+				if (memcmp(out.data(), reference.data(), float_count * sizeof(cgltf_float)) != 0)
+				{
+					printf("%s%s %s: unpacked data differs from cgltf_accessor_read_float\n", normalized ? "n" : "", format.name, padded ? "vec3/4" : "vec4");
+					return 1;
+				}
+
+				double out_bytes = (double)float_count * sizeof(cgltf_float);
+				printf("  %-4s %-10s %-6s %7.2f GB/s out (%6.2f GB/s in), read_float %6.2f GB/s out\n",
+					format.name, normalized ? "normalized" : "", padded ? "vec3/4" : "vec4",
+					out_bytes / bulk * 1e-9, (double)(count * accessor.stride) / bulk * 1e-9, out_bytes / single * 1e-9);
+			}
+		}
+	}
+
+	return 0;
+}
+
+// Measures cgltf_accessor_unpack_indices against per-element cgltf_accessor_read_index for every
+// widening conversion, and verifies that both produce identical results.
+static int bench_indices()
+{
+	const cgltf_size count = 1 << 22;
+	const int iterations = 10;
+
+	std::vector<uint8_t> data(count * 4);
+	for (cgltf_size i = 0; i < data.size(); ++i)
+	{
+		data[i] = (uint8_t)(i * 2654435761u >> 13);
+	}
+
+	cgltf_buffer buffer = {};
+	buffer.size = data.size();
+	buffer.data = data.data();
+
+	cgltf_buffer_view view = {};
+	view.buffer = &buffer;
+	view.size = data.size();
+
+	struct
+	{
+		const char* name;
+		cgltf_component_type component_type;
+		cgltf_size component_size;
+		cgltf_size out_component_size;
+	} formats[] = {
+		{ "u8->u16", cgltf_component_type_r_8u, 1, 2 },
+		{ "u8->u32", cgltf_component_type_r_8u, 1, 4 },
+		{ "u16->u16", cgltf_component_type_r_16u, 2, 2 },
+		{ "u16->u32", cgltf_component_type_r_16u, 2, 4 },
+		{ "u32->u32", cgltf_component_type_r_32u, 4, 4 },
+	};
+
+	std::vector<uint8_t> out(count * 4);
+
+	printf("indices (%s, %d elements)\n", simd_name(), (int)count);
+
+	for (const auto& format : formats)
+	{
+		cgltf_accessor accessor = {};
+		accessor.component_type = format.component_type;
+		accessor.type = cgltf_type_scalar;
+		accessor.count = count;
+		accessor.stride = format.component_size;
+		accessor.buffer_view = &view;
+
+		bench_clock::time_point start = bench_clock::now();
+		for (int it = 0; it < iterations; ++it)
+		{
+			cgltf_accessor_unpack_indices(&accessor, out.data(), format.out_component_size, count);
+		}
+		double bulk = seconds_since(start) / iterations;
+
+		start = bench_clock::now();
+		cgltf_size mismatches = 0;
+		for (cgltf_size i = 0; i < count; ++i)
+		{
+			cgltf_size index = cgltf_accessor_read_index(&accessor, i);
+			cgltf_size unpacked = format.out_component_size == 2 ? ((const uint16_t*)out.data())[i] : ((const uint32_t*)out.data())[i];
+			mismatches += index != unpacked;
+		}
+		double single = seconds_since(start);
+
+		if (mismatches)
+		{
+			printf("%s: unpacked indices differ from cgltf_accessor_read_index\n", format.name);
+			return 1;
+		}
+
+		double out_bytes = (double)(count * format.out_component_size);
+		printf("  %-8s %7.2f GB/s out, read_index %6.2f GB/s out\n", format.name, out_bytes / bulk * 1e-9, out_bytes / single * 1e-9);
+	}
+
+	return 0;
+}
+
+// Measures cgltf_validate and cgltf_validate_parallel on a mesh whose primitives either all share
+// one large 32-bit index buffer or each use their own slice of it.
+static int bench_validate(bool shared)
+{
+	const cgltf_size index_count = 1 << 24;
+	const cgltf_size vertex_count = 1 << 20;
+	const int primitive_count = 64;
+	const int iterations = 10;
+
+	std::vector<uint32_t> indices(index_count);
+	for (cgltf_size i = 0; i < index_count; ++i)
+	{
+		indices[i] = (uint32_t)((i * 2654435761u) % vertex_count);
+	}
+
+	cgltf_size slice_count = shared ? index_count : index_count / primitive_count;
+
+	std::string json = "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":" + std::to_string(index_count * 4) + "}],";
+	json += "\"bufferViews\":[{\"buffer\":0,\"byteLength\":" + std::to_string(index_count * 4) + "}],";
+	json += "\"accessors\":[{\"componentType\":5126,\"count\":" + std::to_string(vertex_count) + ",\"type\":\"VEC3\"}";
+	for (int i = 0; i < (shared ? 1 : primitive_count); ++i)
+	{
+		json += ",{\"bufferView\":0,\"byteOffset\":" + std::to_string(i * slice_count * 4) + ",\"componentType\":5125,\"count\":" + std::to_string(slice_count) + ",\"type\":\"SCALAR\"}";
+	}
+	json += "],\"meshes\":[{\"primitives\":[";
+	for (int i = 0; i < primitive_count; ++i)
+	{
+		json += i ? "," : "";
+		json += "{\"attributes\":{\"POSITION\":0},\"indices\":" + std::to_string(shared ? 1 : i + 1) + "}";
+	}
+	json += "]}]}";
+
+	cgltf_options options = {};
+	cgltf_data* data = NULL;
+	if (cgltf_parse(&options, json.c_str(), json.size(), &data) != cgltf_result_success)
+	{
+		printf("validate: unable to parse the test asset\n");
+		return 1;
+	}
+
+	data->buffers[0].data = indices.data();
+
+	printf("validate (%s, %d primitives %s %d indices)\n", simd_name(), primitive_count, shared ? "sharing" : "splitting", (int)index_count);
+
+	std::vector<unsigned int> thread_counts(1, 1);
+	if (std::thread::hardware_concurrency() > 1)
+	{
+		thread_counts.push_back(std::thread::hardware_concurrency());
+	}
+
+	int failed = 0;
+
+	for (unsigned int thread_count : thread_counts)
+	{
+		options.thread_count = thread_count;
+
+		cgltf_result result = cgltf_result_success;
+		bench_clock::time_point start = bench_clock::now();
+		for (int it = 0; it < iterations; ++it)
+		{
+			result = cgltf_validate_parallel(&options, data);
+		}
+		double elapsed = seconds_since(start) / iterations;
+
+		if (result != cgltf_result_success)
+		{
+			printf("validate: unexpected result %d\n", (int)result);
+			failed = 1;
+			break;
+		}
+
+		printf("  %3u threads %7.2f ms, %6.2f GB/s of index data\n", thread_count, elapsed * 1e3, (double)(index_count * 4) / elapsed * 1e-9);
+	}
+
+	data->buffers[0].data = NULL;
+	cgltf_free(data);
+
+	return failed;
+}
+
+// Measures cgltf_parse on a synthetic document with 1M accessors, which is dominated by matching object keys.
+static int bench_parse()
+{
+	const int accessor_count = 1000000;
+	const int iterations = 5;
+
+	std::string json = "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":1048576}],";
+	json += "\"bufferViews\":[{\"buffer\":0,\"byteLength\":1048576,\"byteStride\":12,\"target\":34962}],\"accessors\":[";
+	for (int i = 0; i < accessor_count; ++i)
+	{
+		json += i ? "," : "";
+		json += "{\"bufferView\":0,\"byteOffset\":" + std::to_string(i % 1024 * 4) + ",\"componentType\":5126,\"normalized\":false,\"count\":" + std::to_string(i % 1000 + 1);
+		json += ",\"type\":\"VEC3\",\"min\":[0,0,0],\"max\":[1,1,1],\"name\":\"accessor\"}";
+	}
+	json += "]}";
+
+	cgltf_options options = {};
+	options.arena = 1;
+
+	double best = 0;
+	for (int it = 0; it < iterations; ++it)
+	{
+		cgltf_data* data = NULL;
+		bench_clock::time_point start = bench_clock::now();
+		cgltf_result result = cgltf_parse(&options, json.c_str(), json.size(), &data);
+		double elapsed = seconds_since(start);
+
+		if (result != cgltf_result_success || data->accessors_count != (cgltf_size)accessor_count)
+		{
+			printf("parse: unable to parse the test document\n");
+			return 1;
+		}
+
+		options.json_token_count = data->json_token_count;
+		cgltf_free(data);
+
+		best = it == 0 || elapsed < best ? elapsed : best;
+	}
+
+	printf("parse (%d accessors, %.1f MB of JSON)\n", accessor_count, (double)json.size() * 1e-6);
+	printf("  %7.2f ms, %6.2f MB/s\n", best * 1e3, (double)json.size() / best * 1e-6);
+
+	return 0;
+}
+
+// Measures cgltf_parse on a document with 200k named nodes, copying the names or pointing into the JSON.
+static int bench_names()
+{
+	const int node_count = 200000;
+	const int iterations = 5;
+
+	std::string json = "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[";
+	for (int i = 0; i < node_count; ++i)
+	{
+		json += i ? "," : "";
+		json += "{\"name\":\"joint_" + std::to_string(i) + "\",\"translation\":[0,1,0]}";
+	}
+	json += "]}";
+
+	printf("names (%d nodes)\n", node_count);
+
+	for (int in_place = 0; in_place < 2; ++in_place)
+	{
+		cgltf_options options = {};
+		options.in_place_strings = in_place;
+
+		double best = 0;
+		for (int it = 0; it < iterations; ++it)
+		{
+			std::vector<char> mutable_json(json.begin(), json.end());
+
+			cgltf_data* data = NULL;
+			bench_clock::time_point start = bench_clock::now();
+			cgltf_result result = cgltf_parse(&options, mutable_json.data(), mutable_json.size(), &data);
+			if (result == cgltf_result_success)
+			{
+				cgltf_free(data);
+			}
+			double elapsed = seconds_since(start);
+
+			if (result != cgltf_result_success)
+			{
+				printf("names: unable to parse the test document\n");
+				return 1;
+			}
+
+			best = it == 0 || elapsed < best ? elapsed : best;
+		}
+
+		printf("  %-8s %7.2f ms parse + free\n", in_place ? "in place" : "copied", best * 1e3);
+	}
+
+	return 0;
+}
+
+// Measures cgltf_find_node_by_name with and without the name index on a document with 20k named nodes.
+static int bench_find()
+{
+	const int node_count = 20000;
+
+	std::string json = "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[";
+	for (int i = 0; i < node_count; ++i)
+	{
+		json += i ? "," : "";
+		json += "{\"name\":\"attachment_point_" + std::to_string(i) + "\"}";
+	}
+	json += "]}";
+
+	printf("find (%d nodes, %d lookups)\n", node_count, node_count);
+
+	for (int name_index = 0; name_index < 2; ++name_index)
+	{
+		cgltf_options options = {};
+		options.name_index = name_index;
+
+		cgltf_data* data = NULL;
+		bench_clock::time_point start = bench_clock::now();
+		if (cgltf_parse(&options, json.c_str(), json.size(), &data) != cgltf_result_success)
+		{
+			printf("find: unable to parse the test document\n");
+			return 1;
+		}
+		double parse = seconds_since(start);
+
+		start = bench_clock::now();
+		cgltf_size found = 0;
+		for (int i = 0; i < node_count; ++i)
+		{
+			std::string name = "attachment_point_" + std::to_string((i * 7919) % node_count);
+			found += cgltf_find_node_by_name(data, name.c_str()) != NULL;
+		}
+		double lookups = seconds_since(start);
+
+		cgltf_free(data);
+
+		if (found != (cgltf_size)node_count)
+		{
+			printf("find: lookups failed\n");
+			return 1;
+		}
+
+		printf("  %-6s parse %7.2f ms, lookups %8.2f ms\n", name_index ? "index" : "scan", parse * 1e3, lookups * 1e3);
+	}
+
+	return 0;
+}
+
+// Measures cgltf_scene_transforms_world against calling cgltf_node_transform_world for every node
+// of a scene made of deep skeleton chains, and verifies that both produce the same matrices.
+static int bench_world()
+{
+	const int chain_count = 1000;
+	const int chain_depth = 64;
+
+	std::string json = "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[";
+	for (int i = 0; i < chain_count * chain_depth; ++i)
+	{
+		json += i ? "," : "";
+		json += "{\"translation\":[0.1,0.5,-0.2],\"rotation\":[0.0499792,0.0,0.0998334,0.9937604],\"scale\":[1.01,1.0,0.99]";
+		if ((i + 1) % chain_depth != 0)
+		{
+			json += ",\"children\":[" + std::to_string(i + 1) + "]";
+		}
+		json += "}";
+	}
+	json += "],\"scenes\":[{\"nodes\":[";
+	for (int i = 0; i < chain_count; ++i)
+	{
+		json += i ? "," : "";
+		json += std::to_string(i * chain_depth);
+	}
+	json += "]}]}";
+
+	cgltf_options options = {};
+	cgltf_data* data = NULL;
+	if (cgltf_parse(&options, json.c_str(), json.size(), &data) != cgltf_result_success)
+	{
+		printf("world: unable to parse the test document\n");
+		return 1;
+	}
+
+	const cgltf_scene* scene = data->scenes;
+	cgltf_size count = cgltf_scene_transforms_world(scene, NULL);
+	std::vector<cgltf_float> per_node(count * 16), batch(count * 16);
+
+	printf("world (%d chains of depth %d)\n", chain_count, chain_depth);
+
+	// chains are laid out in pre-order, which is the order cgltf_scene_transforms_world writes
+	bench_clock::time_point start = bench_clock::now();
+	for (cgltf_size i = 0; i < count; ++i)
+	{
+		cgltf_node_transform_world(data->nodes + i, per_node.data() + i * 16);
+	}
+	double node_time = seconds_since(start);
+
+	start = bench_clock::now();
+	cgltf_size written = cgltf_scene_transforms_world(scene, batch.data());
+	double scene_time = seconds_since(start);
+
+	float max_error = 0;
+	for (cgltf_size i = 0; i < count * 16; ++i)
+	{
+		max_error = std::max(max_error, std::abs(per_node[i] - batch[i]));
+	}
+
+	cgltf_free(data);
+
+	if (written != count || max_error > 1e-3f)
+	{
+		printf("world: matrices differ (max error %g)\n", max_error);
+		return 1;
+	}
+
+	printf("  node   %8.2f ms\n", node_time * 1e3);
+	printf("  scene  %8.2f ms (max error %g)\n", scene_time * 1e3, max_error);
+
+	return 0;
+}
+
+// Scalar reference for the TRS conversion in cgltf_node_transform_local
+static void reference_transform_local(const cgltf_node* node, cgltf_float* lm)
+{
+	float qx = node->rotation[0], qy = node->rotation[1], qz = node->rotation[2], qw = node->rotation[3];
+	float sx = node->scale[0], sy = node->scale[1], sz = node->scale[2];
+
+	lm[0] = (1 - 2 * qy*qy - 2 * qz*qz) * sx;
+	lm[1] = (2 * qx*qy + 2 * qz*qw) * sy;
+	lm[2] = (2 * qx*qz - 2 * qy*qw) * sz;
+	lm[3] = 0.f;
+	lm[4] = (2 * qx*qy - 2 * qz*qw) * sx;
+	lm[5] = (1 - 2 * qx*qx - 2 * qz*qz) * sy;
+	lm[6] = (2 * qy*qz + 2 * qx*qw) * sz;
+	lm[7] = 0.f;
+	lm[8] = (2 * qx*qz + 2 * qy*qw) * sx;
+	lm[9] = (2 * qy*qz - 2 * qx*qw) * sy;
+	lm[10] = (1 - 2 * qx*qx - 2 * qy*qy) * sz;
+	lm[11] = 0.f;
+	lm[12] = node->translation[0];
+	lm[13] = node->translation[1];
+	lm[14] = node->translation[2];
+	lm[15] = 1.f;
+}
+
+// Measures the matrix kernels behind cgltf_node_transform_local, cgltf_node_transform_world and
+// cgltf_scene_transforms_world over a random 100k-node hierarchy, and verifies the local matrices
+// against the scalar reference.
+static int bench_transforms()
+{
+	const int node_count = 100000;
+	const int max_depth = 16;
+
+	// every node is attached to a random node on the path to the previous one, which numbers the
+	// nodes in depth-first pre-order
+	std::vector<std::vector<int> > children(node_count);
+	std::vector<int> path(1, 0);
+	unsigned int seed = 42;
+	for (int i = 1; i < node_count; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		path.resize(1 + (seed >> 8) % std::min((int)path.size(), max_depth - 1));
+		children[path.back()].push_back(i);
+		path.push_back(i);
+	}
+
+	std::string json = "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[";
+	for (int i = 0; i < node_count; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		float angle = (float)(seed >> 8) / (float)(1 << 24) * 3.14159265f;
+		json += i ? "," : "";
+		json += "{\"translation\":[" + std::to_string(i % 7 * 0.25f) + ",0.5,-0.2]";
+		json += ",\"rotation\":[" + std::to_string(std::sin(angle) * 0.6f) + ",0.0," + std::to_string(std::sin(angle) * 0.8f) + "," + std::to_string(std::cos(angle)) + "]";
+		json += ",\"scale\":[1.01,1.0,0.99]";
+		for (size_t j = 0; j < children[i].size(); ++j)
+		{
+			json += (j ? "," : ",\"children\":[") + std::to_string(children[i][j]);
+		}
+		json += children[i].empty() ? "}" : "]}";
+	}
+	json += "],\"scenes\":[{\"nodes\":[0]}]}";
+
+	cgltf_options options = {};
+	cgltf_data* data = NULL;
+	if (cgltf_parse(&options, json.c_str(), json.size(), &data) != cgltf_result_success)
+	{
+		printf("transforms: unable to parse the test document\n");
+		return 1;
+	}
+
+	std::vector<cgltf_float> reference(node_count * 16), local(node_count * 16), world(node_count * 16), scene(node_count * 16);
+
+	printf("transforms (%d nodes, %s)\n", node_count, simd_name());
+
+	// best of several runs, as the kernels are short compared to the noise
+	double reference_time = 1e9, local_time = 1e9, world_time = 1e9, scene_time = 1e9;
+	cgltf_size written = 0;
+	for (int run = 0; run < 5; ++run)
+	{
+		bench_clock::time_point start = bench_clock::now();
+		for (int i = 0; i < node_count; ++i)
+		{
+			reference_transform_local(data->nodes + i, reference.data() + i * 16);
+		}
+		reference_time = std::min(reference_time, seconds_since(start));
+
+		start = bench_clock::now();
+		for (int i = 0; i < node_count; ++i)
+		{
+			cgltf_node_transform_local(data->nodes + i, local.data() + i * 16);
+		}
+		local_time = std::min(local_time, seconds_since(start));
+
+		start = bench_clock::now();
+		for (int i = 0; i < node_count; ++i)
+		{
+			cgltf_node_transform_world(data->nodes + i, world.data() + i * 16);
+		}
+		world_time = std::min(world_time, seconds_since(start));
+
+		start = bench_clock::now();
+		written = cgltf_scene_transforms_world(data->scenes, scene.data());
+		scene_time = std::min(scene_time, seconds_since(start));
+	}
+
+	float local_error = 0, scene_error = 0;
+	for (int i = 0; i < node_count * 16; ++i)
+	{
+		local_error = std::max(local_error, std::abs(reference[i] - local[i]));
+		scene_error = std::max(scene_error, std::abs(world[i] - scene[i]));
+	}
+
+	cgltf_free(data);
+
+	if (written != (cgltf_size)node_count || local_error > 1e-6f || scene_error > 1e-3f)
+	{
+		printf("transforms: matrices differ (local error %g, scene error %g)\n", local_error, scene_error);
+		return 1;
+	}
+
+	printf("  local reference %8.2f ms\n", reference_time * 1e3);
+	printf("  local           %8.2f ms (max error %g)\n", local_time * 1e3, local_error);
+	printf("  world           %8.2f ms\n", world_time * 1e3);
+	printf("  scene           %8.2f ms (max error %g)\n", scene_time * 1e3, scene_error);
+
+	return 0;
+}
+
+// Measures forward playback with cgltf_animation_sample, with and without keyframe cursors, and with
+// cgltf_baked_animation_sample on an animation of 64 nodes with long translation / rotation / scale tracks.
+static int bench_animation()
+{
+	const int node_count = 64;
+	const int key_count = 4096;
+	const int sample_count = key_count * 2;
+
+	std::vector<float> keys(key_count * (1 + 3 + 4 + 3));
+	float* times = keys.data();
+	float* translations = times + key_count;
+	float* rotations = translations + key_count * 3;
+	float* scales = rotations + key_count * 4;
+	for (int i = 0; i < key_count; ++i)
+	{
+		float angle = (float)i * 0.05f;
+		times[i] = (float)i / 30.f;
+		translations[i * 3 + 0] = std::sin(angle);
+		translations[i * 3 + 1] = std::cos(angle);
+		translations[i * 3 + 2] = (float)i * 0.01f;
+		rotations[i * 4 + 0] = 0.f;
+		rotations[i * 4 + 1] = std::sin(angle * 0.5f);
+		rotations[i * 4 + 2] = 0.f;
+		rotations[i * 4 + 3] = std::cos(angle * 0.5f);
+		scales[i * 3 + 0] = scales[i * 3 + 1] = scales[i * 3 + 2] = 1.f + 0.1f * std::sin(angle);
+	}
+
+	std::string json = "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":" + std::to_string(keys.size() * 4) + "}],";
+	json += "\"bufferViews\":[{\"buffer\":0,\"byteLength\":" + std::to_string(keys.size() * 4) + "}],";
+	json += "\"accessors\":[";
+	json += "{\"bufferView\":0,\"componentType\":5126,\"count\":" + std::to_string(key_count) + ",\"type\":\"SCALAR\"},";
+	json += "{\"bufferView\":0,\"byteOffset\":" + std::to_string((translations - times) * 4) + ",\"componentType\":5126,\"count\":" + std::to_string(key_count) + ",\"type\":\"VEC3\"},";
+	json += "{\"bufferView\":0,\"byteOffset\":" + std::to_string((rotations - times) * 4) + ",\"componentType\":5126,\"count\":" + std::to_string(key_count) + ",\"type\":\"VEC4\"},";
+	json += "{\"bufferView\":0,\"byteOffset\":" + std::to_string((scales - times) * 4) + ",\"componentType\":5126,\"count\":" + std::to_string(key_count) + ",\"type\":\"VEC3\"}],";
+	json += "\"nodes\":[";
+	for (int i = 0; i < node_count; ++i)
+	{
+		json += i ? ",{}" : "{}";
+	}
+	json += "],\"animations\":[{\"samplers\":[{\"input\":0,\"output\":1},{\"input\":0,\"output\":2},{\"input\":0,\"output\":3}],\"channels\":[";
+	const char* paths[] = { "translation", "rotation", "scale" };
+	for (int i = 0; i < node_count * 3; ++i)
+	{
+		json += i ? "," : "";
+		json += "{\"sampler\":" + std::to_string(i % 3) + ",\"target\":{\"node\":" + std::to_string(i / 3) + ",\"path\":\"" + paths[i % 3] + "\"}}";
+	}
+	json += "]}]}";
+
+	cgltf_options options = {};
+	cgltf_data* data = NULL;
+	if (cgltf_parse(&options, json.c_str(), json.size(), &data) != cgltf_result_success)
+	{
+		printf("animation: unable to parse the test document\n");
+		return 1;
+	}
+
+	data->buffers[0].data = keys.data();
+
+	const cgltf_animation* animation = data->animations;
+	cgltf_size float_count = cgltf_animation_sample(animation, 0.f, NULL, NULL, 0);
+	std::vector<cgltf_float> pose(float_count), cursor_pose(float_count);
+	std::vector<cgltf_size> cursors(animation->channels_count);
+	float duration = times[key_count - 1];
+
+	printf("animation (%d channels, %d keys, %d samples)\n", (int)animation->channels_count, key_count, sample_count);
+
+	double search_time = 0, cursor_time = 0;
+	int failed = 0;
+	for (int i = 0; i < sample_count && !failed; ++i)
+	{
+		float time = duration * (float)i / (float)sample_count;
+
+		bench_clock::time_point start = bench_clock::now();
+		cgltf_animation_sample(animation, time, NULL, pose.data(), float_count);
+		search_time += seconds_since(start);
+
+		start = bench_clock::now();
+		cgltf_animation_sample(animation, time, cursors.data(), cursor_pose.data(), float_count);
+		cursor_time += seconds_since(start);
+
+		failed = memcmp(pose.data(), cursor_pose.data(), float_count * sizeof(cgltf_float)) != 0;
+	}
+
+	double baked_time[2] = {}, bake_time[2] = {};
+	for (int quantize = 0; quantize < 2 && !failed; ++quantize)
+	{
+		cgltf_baked_animation* baked = NULL;
+		bench_clock::time_point start = bench_clock::now();
+		failed = cgltf_bake_animation(&options, animation, 60.f, quantize, &baked) != cgltf_result_success;
+		bake_time[quantize] = seconds_since(start);
+
+		for (int i = 0; i < sample_count && !failed; ++i)
+		{
+			float time = duration * (float)i / (float)sample_count;
+
+			start = bench_clock::now();
+			cgltf_baked_animation_sample(baked, time, pose.data(), float_count);
+			baked_time[quantize] += seconds_since(start);
+		}
+
+		cgltf_free_baked_animation(baked);
+	}
+
+	data->buffers[0].data = NULL;
+	cgltf_free(data);
+
+	if (failed)
+	{
+		printf("animation: sampling with cursors differs or baking failed\n");
+		return 1;
+	}
+
+	printf("  search %8.2f ms, %6.1f ns per channel\n", search_time * 1e3, search_time * 1e9 / sample_count / (double)(node_count * 3));
+	printf("  cursor %8.2f ms, %6.1f ns per channel\n", cursor_time * 1e3, cursor_time * 1e9 / sample_count / (double)(node_count * 3));
+	printf("  baked  %8.2f ms, %6.1f ns per channel (baking at 60 fps took %.2f ms)\n", baked_time[0] * 1e3, baked_time[0] * 1e9 / sample_count / (double)(node_count * 3), bake_time[0] * 1e3);
+	printf("  packed %8.2f ms, %6.1f ns per channel (baking with quantized rotations took %.2f ms)\n", baked_time[1] * 1e3, baked_time[1] * 1e9 / sample_count / (double)(node_count * 3), bake_time[1] * 1e3);
+
+	return 0;
+}
+
+static cgltf_size count_bytes(void* user, const void* data, cgltf_size size)
+{
+	(void)data;
+	*(cgltf_size*)user += size;
+	return size;
+}
+
+// Measures writing a document with 200k accessors, either with cgltf_write measuring and then filling
+// a buffer, or in a single pass with cgltf_write_stream.
+static int bench_write()
+{
+	const int accessor_count = 200000;
+	const int iterations = 5;
+
+	std::string json = "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":1048576}],";
+	json += "\"bufferViews\":[{\"buffer\":0,\"byteLength\":1048576,\"byteStride\":12}],\"accessors\":[";
+	for (int i = 0; i < accessor_count; ++i)
+	{
+		json += i ? "," : "";
+		json += "{\"bufferView\":0,\"byteOffset\":" + std::to_string(i % 1024 * 4) + ",\"componentType\":5126,\"count\":" + std::to_string(i % 1000 + 1);
+		json += ",\"type\":\"VEC3\",\"min\":[-" + std::to_string(i % 97) + ".125,0.1,-3.75e-05],\"max\":[" + std::to_string(i % 89) + ".5,1.3333334,2]}";
+	}
+	json += "]}";
+
+	cgltf_options options = {};
+	cgltf_data* data = NULL;
+	if (cgltf_parse(&options, json.c_str(), json.size(), &data) != cgltf_result_success)
+	{
+		printf("write: unable to parse the test document\n");
+		return 1;
+	}
+
+	double two_pass = 0, single_pass = 0;
+	cgltf_size size = 0, streamed = 0;
+	for (int it = 0; it < iterations; ++it)
+	{
+		bench_clock::time_point start = bench_clock::now();
+		size = cgltf_write(&options, NULL, 0, data);
+		std::vector<char> buffer(size);
+		cgltf_write(&options, buffer.data(), size, data);
+		double elapsed = seconds_since(start);
+		two_pass = it == 0 || elapsed < two_pass ? elapsed : two_pass;
+
+		streamed = 0;
+		start = bench_clock::now();
+		cgltf_result result = cgltf_write_stream(&options, count_bytes, &streamed, data);
+		elapsed = seconds_since(start);
+		single_pass = it == 0 || elapsed < single_pass ? elapsed : single_pass;
+
+		if (result != cgltf_result_success || streamed + 1 != size)
+		{
+			printf("write: cgltf_write_stream wrote %d bytes instead of %d\n", (int)streamed, (int)size - 1);
+			cgltf_free(data);
+			return 1;
+		}
+	}
+
+	cgltf_free(data);
+
+	printf("write (%d accessors, %.1f MB of JSON)\n", accessor_count, (double)streamed * 1e-6);
+	printf("  two pass    %7.2f ms, %6.2f MB/s\n", two_pass * 1e3, (double)streamed / two_pass * 1e-6);
+	printf("  single pass %7.2f ms, %6.2f MB/s\n", single_pass * 1e3, (double)streamed / single_pass * 1e-6);
+
+	return 0;
+}
+
+// Measures float formatting with snprintf("%g") against the writer's shortest round-trip formatter, and
+// writes and parses a document with 100k accessors whose bounds are random floats, verifying that every
+// float survives the round trip exactly.
+static int bench_roundtrip()
+{
+	const int float_count = 1000000;
+	const int accessor_count = 100000;
+
+	std::vector<float> floats(float_count);
+	unsigned int seed = 7;
+	for (int i = 0; i < float_count; ++i)
+	{
+		// random finite floats over the whole exponent range
+		do
+		{
+			seed = seed * 1664525u + 1013904223u;
+			uint32_t bits = seed ^ (seed << 13);
+			memcpy(&floats[i], &bits, sizeof(float));
+		} while (!std::isfinite(floats[i]));
+	}
+
+	char str[32];
+	size_t checksum = 0;
+	bench_clock::time_point start = bench_clock::now();
+	for (int i = 0; i < float_count; ++i)
+	{
+		checksum += snprintf(str, sizeof(str), "%g", floats[i]);
+	}
+	double printf_time = seconds_since(start);
+
+	start = bench_clock::now();
+	for (int i = 0; i < float_count; ++i)
+	{
+		checksum += cgltf_format_float(str, floats[i]);
+	}
+	double format_time = seconds_since(start);
+
+	std::string json = "{\"asset\":{\"version\":\"2.0\"},\"accessors\":[";
+	for (int i = 0; i < accessor_count; ++i)
+	{
+		json += i ? "," : "";
+		json += "{\"componentType\":5126,\"count\":1,\"type\":\"SCALAR\",\"min\":[0],\"max\":[0]}";
+	}
+	json += "]}";
+
+	cgltf_options options = {};
+	cgltf_data* data = NULL;
+	if (cgltf_parse(&options, json.c_str(), json.size(), &data) != cgltf_result_success)
+	{
+		printf("roundtrip: unable to parse the test document\n");
+		return 1;
+	}
+
+	for (int i = 0; i < accessor_count; ++i)
+	{
+		data->accessors[i].min[0] = floats[i * 2];
+		data->accessors[i].max[0] = floats[i * 2 + 1];
+	}
+
+	start = bench_clock::now();
+	std::vector<char> written(cgltf_write(&options, NULL, 0, data));
+	cgltf_write(&options, written.data(), written.size(), data);
+	double write_time = seconds_since(start);
+
+	cgltf_data* parsed = NULL;
+	start = bench_clock::now();
+	cgltf_result result = cgltf_parse(&options, written.data(), written.size() - 1, &parsed);
+	double parse_time = seconds_since(start);
+
+	int mismatches = 0;
+	for (int i = 0; result == cgltf_result_success && i < accessor_count; ++i)
+	{
+		mismatches += memcmp(&parsed->accessors[i].min[0], &floats[i * 2], sizeof(float)) != 0;
+		mismatches += memcmp(&parsed->accessors[i].max[0], &floats[i * 2 + 1], sizeof(float)) != 0;
+	}
+
+	cgltf_free(parsed);
+	cgltf_free(data);
+
+	printf("roundtrip (%d floats, %d accessors)\n", float_count, accessor_count);
+	printf("  format %%g     %7.2f ms, %6.1f ns per float\n", printf_time * 1e3, printf_time * 1e9 / float_count);
+	printf("  format short  %7.2f ms, %6.1f ns per float\n", format_time * 1e3, format_time * 1e9 / float_count);
+	printf("  write %7.2f ms, parse %7.2f ms, %d of %d floats differ\n", write_time * 1e3, parse_time * 1e3, mismatches, accessor_count * 2);
+
+	if (result != cgltf_result_success || mismatches != 0 || checksum == 0)
+	{
+		printf("roundtrip: floats did not survive writing and parsing\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+// Measures cgltf_load_buffers on a scene whose geometry is split across many .bin files on local disk,
+// reading them serially and as parallel tasks. The files were just written, so they are likely cached.
+static int bench_buffers()
+{
+	const int buffer_count = 64;
+	const cgltf_size buffer_size = 4 << 20;
+	const int iterations = 5;
+	const char* gltf_path = "bench_buffers.gltf";
+
+	int failed = 0;
+
+	std::vector<uint8_t> contents(buffer_size);
+	std::string json = "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[";
+	for (int i = 0; i < buffer_count; ++i)
+	{
+		for (cgltf_size j = 0; j < buffer_size; ++j)
+		{
+			contents[j] = (uint8_t)((j * 2654435761u) >> 24) ^ (uint8_t)i;
+		}
+
+		std::string path = "bench_buffers_" + std::to_string(i) + ".bin";
+		FILE* file = fopen(path.c_str(), "wb");
+		if (!file || fwrite(contents.data(), 1, buffer_size, file) != buffer_size)
+		{
+			printf("buffers: unable to write %s\n", path.c_str());
+			if (file)
+			{
+				fclose(file);
+			}
+			failed = 1;
+			break;
+		}
+		fclose(file);
+
+		json += i ? "," : "";
+		json += "{\"uri\":\"" + path + "\",\"byteLength\":" + std::to_string(buffer_size) + "}";
+	}
+	json += "]}";
+
+	if (!failed)
+	{
+		printf("buffers (%d files of %d MB)\n", buffer_count, (int)(buffer_size >> 20));
+	}
+
+	// File reads mostly wait, so the parallel path uses at least 8 threads even on small machines
+	unsigned int parallel_threads = std::max(8u, std::thread::hardware_concurrency());
+
+	for (int parallel = 0; parallel < 2 && !failed; ++parallel)
+	{
+		cgltf_options options = {};
+		options.parallel_buffers = parallel;
+		options.thread_count = parallel ? parallel_threads : 1;
+
+		double best = 1e9;
+		for (int it = 0; it < iterations && !failed; ++it)
+		{
+			cgltf_data* data = NULL;
+			cgltf_result result = cgltf_parse(&options, json.c_str(), json.size(), &data);
+
+			bench_clock::time_point start = bench_clock::now();
+			if (result == cgltf_result_success)
+			{
+				result = cgltf_load_buffers(&options, data, gltf_path);
+			}
+			best = std::min(best, seconds_since(start));
+
+			if (result != cgltf_result_success || ((const uint8_t*)data->buffers[buffer_count - 1].data)[buffer_size - 1] != contents[buffer_size - 1])
+			{
+				printf("buffers: unexpected result %d\n", (int)result);
+				failed = 1;
+			}
+
+			cgltf_free(data);
+		}
+
+		if (!failed)
+		{
+			printf("  %-8s %3u threads %7.2f ms, %6.2f GB/s\n", parallel ? "parallel" : "serial", (unsigned int)options.thread_count, best * 1e3, (double)buffer_count * buffer_size / best * 1e-9);
+		}
+	}
+
+	// Files that were not written before a failure do not exist, and removing them fails harmlessly
+	for (int i = 0; i < buffer_count; ++i)
+	{
+		remove(("bench_buffers_" + std::to_string(i) + ".bin").c_str());
+	}
+
+	return failed;
+}
+
+// The character-at-a-time decoder that cgltf_load_buffer_base64 used before it was table-driven
+static bool reference_base64(cgltf_size size, const char* base64, unsigned char* data)
+{
+	unsigned int buffer = 0;
+	unsigned int buffer_bits = 0;
+
+	for (cgltf_size i = 0; i < size; ++i)
+	{
+		while (buffer_bits < 8)
+		{
+			char ch = *base64++;
+
+			int index =
+				(unsigned)(ch - 'A') < 26 ? (ch - 'A') :
+				(unsigned)(ch - 'a') < 26 ? (ch - 'a') + 26 :
+				(unsigned)(ch - '0') < 10 ? (ch - '0') + 52 :
+				ch == '+' ? 62 :
+				ch == '/' ? 63 :
+				-1;
+
+			if (index < 0)
+			{
+				return false;
+			}
+
+			buffer = (buffer << 6) | index;
+			buffer_bits += 6;
+		}
+
+		data[i] = (unsigned char)(buffer >> (buffer_bits - 8));
+		buffer_bits -= 8;
+	}
+
+	return true;
+}
+
+static void* reuse_alloc(void* user, cgltf_size size)
+{
+	(void)size;
+	return user;
+}
+
+static void reuse_free(void* user, void* ptr)
+{
+	(void)user;
+	(void)ptr;
+}
+
+// Measures cgltf_load_buffer_base64 against the character-at-a-time decoder on a large embedded buffer.
+static int bench_base64()
+{
+	const cgltf_size size = 64 << 20;
+	const int iterations = 5;
+	static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	std::vector<unsigned char> data(size);
+	for (cgltf_size i = 0; i < size; ++i)
+	{
+		data[i] = (unsigned char)((i * 2654435761u) >> 13);
+	}
+
+	std::string base64;
+	base64.reserve((size + 2) / 3 * 4);
+	for (cgltf_size i = 0; i < size; i += 3)
+	{
+		unsigned int bits = (data[i] << 16) | (i + 1 < size ? data[i + 1] << 8 : 0) | (i + 2 < size ? data[i + 2] : 0);
+		base64 += alphabet[bits >> 18];
+		base64 += alphabet[(bits >> 12) & 63];
+		base64 += i + 1 < size ? alphabet[(bits >> 6) & 63] : '=';
+		base64 += i + 2 < size ? alphabet[bits & 63] : '=';
+	}
+
+	std::vector<unsigned char> reference(size);
+	double reference_time = 1e9;
+	for (int it = 0; it < iterations; ++it)
+	{
+		bench_clock::time_point start = bench_clock::now();
+		reference_base64(size, base64.c_str(), reference.data());
+		reference_time = std::min(reference_time, seconds_since(start));
+	}
+
+	// Decode into the same memory every time, so that page faults of fresh allocations are not measured
+	std::vector<unsigned char> output(size);
+	cgltf_options options = {};
+	options.memory_alloc = reuse_alloc;
+	options.memory_free = reuse_free;
+	options.memory_user_data = output.data();
+
+	double decode_time = 1e9;
+	int failed = 0;
+	for (int it = 0; it < iterations && !failed; ++it)
+	{
+		void* decoded = NULL;
+		bench_clock::time_point start = bench_clock::now();
+		cgltf_result result = cgltf_load_buffer_base64(&options, size, base64.c_str(), &decoded);
+		decode_time = std::min(decode_time, seconds_since(start));
+
+		failed = result != cgltf_result_success || memcmp(decoded, data.data(), size) != 0 || memcmp(reference.data(), data.data(), size) != 0;
+	}
+
+	if (failed)
+	{
+		printf("base64: decoded data differs\n");
+		return 1;
+	}
+
+	printf("base64 (%s, %d MB)\n", simd_name(), (int)(size >> 20));
+	printf("  reference %7.2f ms, %6.2f GB/s\n", reference_time * 1e3, (double)base64.size() / reference_time * 1e-9);
+	printf("  cgltf     %7.2f ms, %6.2f GB/s\n", decode_time * 1e3, (double)base64.size() / decode_time * 1e-9);
+
+	return 0;
+}
+
+// Measures reading one mesh of a tile whose meshes share a large .bin file, loading all buffers up front
+// against loading them lazily and prefetching only that mesh.
+static int bench_lazy()
+{
+	const int mesh_count = 64;
+	const cgltf_size view_size = 4 << 20;
+	const int iterations = 5;
+	const char* gltf_path = "bench_lazy.gltf";
+	const char* bin_path = "bench_lazy.bin";
+
+	std::vector<uint8_t> contents(view_size * mesh_count);
+	for (cgltf_size i = 0; i < contents.size(); ++i)
+	{
+		contents[i] = (uint8_t)((i * 2654435761u) >> 24);
+	}
+
+	FILE* file = fopen(bin_path, "wb");
+	if (!file || fwrite(contents.data(), 1, contents.size(), file) != contents.size())
+	{
+		printf("lazy: unable to write %s\n", bin_path);
+		if (file)
+		{
+			fclose(file);
+		}
+		return 1;
+	}
+	fclose(file);
+
+	std::string json = "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"uri\":\"" + std::string(bin_path) + "\",\"byteLength\":" + std::to_string(contents.size()) + "}],";
+	std::string views = "\"bufferViews\":[", accessors = "\"accessors\":[", meshes = "\"meshes\":[";
+	for (int i = 0; i < mesh_count; ++i)
+	{
+		const char* separator = i ? "," : "";
+		views += separator + std::string("{\"buffer\":0,\"byteOffset\":") + std::to_string(i * view_size) + ",\"byteLength\":" + std::to_string(view_size) + "}";
+		accessors += separator + std::string("{\"bufferView\":") + std::to_string(i) + ",\"componentType\":5126,\"count\":" + std::to_string(view_size / 12) + ",\"type\":\"VEC3\"}";
+		meshes += separator + std::string("{\"primitives\":[{\"attributes\":{\"POSITION\":") + std::to_string(i) + "}}]}";
+	}
+	json += views + "]," + accessors + "]," + meshes + "]}";
+
+	double times[2] = {1e9, 1e9};
+	int failed = 0;
+
+	for (int lazy = 0; lazy < 2 && !failed; ++lazy)
+	{
+		for (int it = 0; it < iterations && !failed; ++it)
+		{
+			cgltf_options options = {};
+			cgltf_data* data = NULL;
+			cgltf_result result = cgltf_parse(&options, json.c_str(), json.size(), &data);
+
+			bench_clock::time_point start = bench_clock::now();
+			cgltf_mesh* mesh = result == cgltf_result_success ? &data->meshes[mesh_count / 2] : NULL;
+			if (result == cgltf_result_success)
+			{
+				result = lazy ? cgltf_load_buffers_lazy(&options, data, gltf_path) : cgltf_load_buffers(&options, data, gltf_path);
+			}
+			if (result == cgltf_result_success)
+			{
+				result = cgltf_prefetch_meshes(&mesh, 1);
+			}
+			times[lazy] = std::min(times[lazy], seconds_since(start));
+
+			const void* view_data = result == cgltf_result_success ? cgltf_buffer_view_data(mesh->primitives[0].attributes[0].data->buffer_view) : NULL;
+			if (!view_data || memcmp(view_data, contents.data() + (mesh_count / 2) * view_size, view_size) != 0)
+			{
+				printf("lazy: unexpected result %d\n", (int)result);
+				failed = 1;
+			}
+
+			cgltf_free(data);
+		}
+	}
+
+	remove(bin_path);
+
+	if (failed)
+	{
+		return 1;
+	}
+
+	printf("lazy (1 of %d meshes, %d MB each)\n", mesh_count, (int)(view_size >> 20));
+	printf("  load all  %7.2f ms, %4d MB read\n", times[0] * 1e3, (int)(contents.size() >> 20));
+	printf("  lazy      %7.2f ms, %4d MB read\n", times[1] * 1e3, (int)(view_size >> 20));
+
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	int result = 0;
+
+	if (bench_enabled(argc, argv, "dequantize"))
+	{
+		result |= bench_dequantize();
+	}
+
+	if (bench_enabled(argc, argv, "indices"))
+	{
+		result |= bench_indices();
+	}
+
+	if (bench_enabled(argc, argv, "validate"))
+	{
+		result |= bench_validate(true);
+		result |= bench_validate(false);
+	}
+
+	if (bench_enabled(argc, argv, "parse"))
+	{
+		result |= bench_parse();
+	}
+
+	if (bench_enabled(argc, argv, "names"))
+	{
+		result |= bench_names();
+	}
+
+	if (bench_enabled(argc, argv, "find"))
+	{
+		result |= bench_find();
+	}
+
+	if (bench_enabled(argc, argv, "world"))
+	{
+		result |= bench_world();
+	}
+
+	if (bench_enabled(argc, argv, "transforms"))
+	{
+		result |= bench_transforms();
+	}
+
+	if (bench_enabled(argc, argv, "animation"))
+	{
+		result |= bench_animation();
+	}
+
+	if (bench_enabled(argc, argv, "write"))
+	{
+		result |= bench_write();
+	}
+
+	if (bench_enabled(argc, argv, "roundtrip"))
+	{
+		result |= bench_roundtrip();
+	}
+
+	if (bench_enabled(argc, argv, "buffers"))
+	{
+		result |= bench_buffers();
+	}
+
+	if (bench_enabled(argc, argv, "base64"))
+	{
+		result |= bench_base64();
+	}
+
+	if (bench_enabled(argc, argv, "lazy"))
+	{
+		result |= bench_lazy();
+	}
+
+	return result;
+}
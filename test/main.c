@@ -14,6 +14,7 @@ int main(int argc, char** argv)
 	}
 
 	cgltf_options options = {0};
+	options.name_index = 1;
 	cgltf_data* data = NULL;
 	cgltf_result result = cgltf_parse_file(&options, argv[1], &data);
 
@@ -29,6 +30,26 @@ int main(int argc, char** argv)
 	{
 		printf("Type: %u\n", data->file_type);
 		printf("Meshes: %lu\n", data->meshes_count);
+
+		for (cgltf_size i = 0; i < data->nodes_count; ++i)
+		{
+			cgltf_node* found = cgltf_find_node_by_name(data, data->nodes[i].name);
+			if (data->nodes[i].name && (!found || found > data->nodes + i || strcmp(found->name, data->nodes[i].name) != 0))
+			{
+				printf("Node %lu not found by name\n", i);
+				result = cgltf_result_invalid_gltf;
+			}
+		}
+
+		for (cgltf_size i = 0; i < data->meshes_count; ++i)
+		{
+			cgltf_mesh* found = cgltf_find_mesh_by_name(data, data->meshes[i].name);
+			if (data->meshes[i].name && (!found || found > data->meshes + i || strcmp(found->name, data->meshes[i].name) != 0))
+			{
+				printf("Mesh %lu not found by name\n", i);
+				result = cgltf_result_invalid_gltf;
+			}
+		}
 	}
 
 	cgltf_free(data);
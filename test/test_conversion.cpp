@@ -4,13 +4,153 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <string>
+#include <utility>
+#include <vector>
 
 static bool is_near(cgltf_float a, cgltf_float b)
 {
 	return std::abs(a - b) < 10 * std::numeric_limits<cgltf_float>::min();
 }
 
+static void run_tasks_reversed(void* user, cgltf_size task_count, void (*task)(void* task_data, cgltf_size task_index), void* task_data)
+{
+	(void)user;
+	for (cgltf_size i = task_count; i > 0; --i)
+	{
+		task(task_data, i - 1);
+	}
+}
+
+struct test_files
+{
+	int outstanding;
+	std::vector<std::pair<cgltf_buffer_loader*, cgltf_size> > requests;
+	std::vector<std::string> paths;
+	std::vector<cgltf_size> sizes;
+};
+
+static cgltf_result test_file_read(void* user, const char* path, cgltf_size* size, void** data)
+{
+	test_files* files = (test_files*)user;
+
+	FILE* file = fopen(path, "rb");
+	if (!file)
+		return cgltf_result_file_not_found;
+
+	std::vector<char> contents;
+	char chunk[4096];
+	for (size_t read; (read = fread(chunk, 1, sizeof(chunk), file)) > 0;)
+		contents.insert(contents.end(), chunk, chunk + read);
+	fclose(file);
+
+	if (*size == 0)
+		*size = contents.size();
+	if (contents.size() < *size)
+		return cgltf_result_io_error;
+
+	*data = malloc(*size ? *size : 1);
+	memcpy(*data, contents.data(), *size);
+	files->outstanding++;
+	return cgltf_result_success;
+}
+
+static void test_file_release(void* user, void* data)
+{
+	test_files* files = (test_files*)user;
+	files->outstanding--;
+	free(data);
+}
+
+static void test_file_read_async(void* user, const char* path, cgltf_size size, cgltf_buffer_loader* loader, cgltf_size request)
+{
+	test_files* files = (test_files*)user;
+	files->requests.push_back(std::make_pair(loader, request));
+	files->paths.push_back(path);
+	files->sizes.push_back(size);
+}
+
+// Reference decoder for base64 data URIs, one character at a time
+static std::vector<unsigned char> decode_data_uri(const char* uri)
+{
+	static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	std::vector<unsigned char> result;
+	unsigned int buffer = 0, buffer_bits = 0;
+	for (const char* ch = strchr(uri, ',') + 1; *ch && *ch != '='; ++ch)
+	{
+		buffer = (buffer << 6) | (unsigned int)(strchr(alphabet, *ch) - alphabet);
+		buffer_bits += 6;
+		if (buffer_bits >= 8)
+		{
+			result.push_back((unsigned char)(buffer >> (buffer_bits - 8)));
+			buffer_bits -= 8;
+		}
+	}
+	return result;
+}
+
+static bool check_scene_transforms(const cgltf_node* node, const cgltf_float* matrices, cgltf_size* index)
+{
+	cgltf_float world[16];
+	cgltf_node_transform_world(node, world);
+
+	const cgltf_float* batch = matrices + *index * 16;
+	*index += 1;
+
+	for (int i = 0; i < 16; ++i)
+	{
+		if (std::abs(world[i] - batch[i]) > 1e-4f * std::max(1.f, std::abs(world[i])))
+			return false;
+	}
+
+	for (cgltf_size i = 0; i < node->children_count; ++i)
+	{
+		if (!check_scene_transforms(node->children[i], matrices, index))
+			return false;
+	}
+
+	return true;
+}
+
+// Numbers parse to the float nearest to their decimal value, including ones that a double would round to the wrong float
+static bool check_float_parsing()
+{
+	static const char* const numbers[16] = {
+		"1.0000000596046448", "7.038531e-26", "-7.038531e-26", "0.1",
+		"16777217", "123456789", "3.4028235e38", "1.17549435e-38",
+		"1e-45", "-0.0", "0.30000001192092896", "9.999999e-11",
+		"1e10", "2.7182817", "1.00000006", "4.7019774e-38",
+	};
+
+	std::string json = "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[{\"matrix\":[";
+	for (int i = 0; i < 16; ++i)
+		json += (i ? "," : "") + std::string(numbers[i]);
+	json += "]}]}";
+
+	cgltf_options options = {};
+	cgltf_data* data = NULL;
+	if (cgltf_parse(&options, json.c_str(), json.size(), &data) != cgltf_result_success)
+		return false;
+
+	bool result = true;
+	for (int i = 0; i < 16; ++i)
+	{
+		float expected = strtof(numbers[i], NULL);
+		if (memcmp(&data->nodes[0].matrix[i], &expected, sizeof(float)) != 0)
+		{
+			printf("%s parses to %.9g instead of %.9g\n", numbers[i], data->nodes[0].matrix[i], expected);
+			result = false;
+		}
+	}
+
+	cgltf_free(data);
+	return result;
+}
+
 int main(int argc, char** argv)
 {
 	if (argc < 2)
@@ -19,6 +159,9 @@ int main(int argc, char** argv)
 		return -1;
 	}
 
+	if (!check_float_parsing())
+		return -1;
+
 	cgltf_options options = {};
 	cgltf_data* data = NULL;
 	cgltf_result result = cgltf_parse_file(&options, argv[1], &data);
@@ -29,15 +172,147 @@ int main(int argc, char** argv)
 	if (result != cgltf_result_success || strstr(argv[1], "Draco"))
 		return result;
 
+	cgltf_options parallel_options = {};
+	parallel_options.run_tasks = run_tasks_reversed;
+	if (cgltf_validate_parallel(&parallel_options, data) != cgltf_validate(data))
+	{
+		printf("cgltf_validate_parallel differs from cgltf_validate\n");
+		return -1;
+	}
+
+	for (cgltf_size scene_index = 0; scene_index < data->scenes_count; ++scene_index)
+	{
+		const cgltf_scene* scene = data->scenes + scene_index;
+		std::vector<cgltf_float> matrices(cgltf_scene_transforms_world(scene, NULL) * 16);
+		cgltf_size written = cgltf_scene_transforms_world(scene, matrices.data());
+
+		cgltf_size index = 0;
+		for (cgltf_size i = 0; i < scene->nodes_count; ++i)
+		{
+			if (!check_scene_transforms(scene->nodes[i], matrices.data(), &index))
+				index = written + 1;
+		}
+
+		if (index != written || written * 16 != matrices.size())
+		{
+			printf("cgltf_scene_transforms_world differs from cgltf_node_transform_world in scene %d\n", (int)scene_index);
+			return -1;
+		}
+	}
+
+	for (cgltf_size animation_index = 0; animation_index < data->animations_count; ++animation_index)
+	{
+		const cgltf_animation* animation = data->animations + animation_index;
+		cgltf_size float_count = cgltf_animation_sample(animation, 0.f, NULL, NULL, 0);
+		std::vector<cgltf_float> pose(float_count), cursor_pose(float_count);
+		std::vector<cgltf_size> cursors(animation->channels_count);
+
+		cgltf_float duration = 0.f;
+		for (cgltf_size i = 0; i < animation->samplers_count; ++i)
+		{
+			const cgltf_accessor* input = animation->samplers[i].input;
+			if (input && input->has_max)
+				duration = std::max(duration, input->max[0]);
+		}
+
+		// sampling forward with cursors must match sampling each time from scratch
+		for (int step = -1; step <= 64; ++step)
+		{
+			cgltf_float time = duration * (cgltf_float)step / 60.f;
+			if (cgltf_animation_sample(animation, time, NULL, pose.data(), float_count) != float_count ||
+				cgltf_animation_sample(animation, time, cursors.data(), cursor_pose.data(), float_count) != float_count ||
+				memcmp(pose.data(), cursor_pose.data(), float_count * sizeof(cgltf_float)) != 0)
+			{
+				printf("Sampling animation %d with cursors differs at time %f\n", (int)animation_index, time);
+				return -1;
+			}
+		}
+
+		// baked clips must reproduce the animation at their frame times
+		for (int quantize = 0; quantize < 2; ++quantize)
+		{
+			cgltf_baked_animation* baked = NULL;
+			if (cgltf_bake_animation(&options, animation, 30.f, quantize, &baked) != cgltf_result_success ||
+				cgltf_baked_animation_sample(baked, 0.f, NULL, 0) != float_count)
+			{
+				printf("Unable to bake animation %d\n", (int)animation_index);
+				return -1;
+			}
+
+			for (cgltf_size frame = 0; frame < baked->frame_count; ++frame)
+			{
+				cgltf_float time = (cgltf_float)frame / 30.f;
+				cgltf_animation_sample(animation, time, NULL, pose.data(), float_count);
+				cgltf_baked_animation_sample(baked, time, cursor_pose.data(), float_count);
+
+				cgltf_size offset = 0;
+				for (cgltf_size i = 0; i < animation->channels_count; ++i)
+				{
+					const cgltf_animation_channel* channel = animation->channels + i;
+					cgltf_size components = cgltf_animation_channel_sample(channel, time, NULL, NULL, 0);
+					const cgltf_float* expected = pose.data() + offset;
+					const cgltf_float* sampled = cursor_pose.data() + offset;
+					bool near = true;
+
+					if (channel->target_path == cgltf_animation_path_type_rotation)
+					{
+						// q and -q are the same rotation, so the sampled quaternion is compared in the hemisphere of the expected one
+						cgltf_float dot = expected[0] * sampled[0] + expected[1] * sampled[1] + expected[2] * sampled[2] + expected[3] * sampled[3];
+						cgltf_float sign = dot < 0.f ? -1.f : 1.f;
+						for (cgltf_size c = 0; c < components; ++c)
+							near = near && std::abs(sign * sampled[c] - expected[c]) < 1e-3f;
+					}
+					else
+					{
+						for (cgltf_size c = 0; c < components; ++c)
+							near = near && std::abs(sampled[c] - expected[c]) <= 1e-4f * std::max(1.f, std::abs(expected[c]));
+					}
+
+					if (!near)
+					{
+						printf("Baked channel %d of animation %d differs at frame %d\n", (int)i, (int)animation_index, (int)frame);
+						return -1;
+					}
+
+					offset += components;
+				}
+			}
+
+			cgltf_free_baked_animation(baked);
+		}
+
+		// linear translations and scales must reproduce their keyframes
+		for (cgltf_size i = 0; i < animation->channels_count; ++i)
+		{
+			const cgltf_animation_channel* channel = animation->channels + i;
+			const cgltf_animation_sampler* sampler = channel->sampler;
+			if (sampler->interpolation != cgltf_interpolation_type_linear ||
+				(channel->target_path != cgltf_animation_path_type_translation && channel->target_path != cgltf_animation_path_type_scale))
+				continue;
+
+			for (cgltf_size key = 0; key < sampler->input->count; ++key)
+			{
+				cgltf_float time = 0.f, expected[4] = {}, sampled[3] = {};
+				cgltf_accessor_read_float(sampler->input, key, &time, 1);
+				cgltf_accessor_read_float(sampler->output, key, expected, 4);
+				cgltf_animation_channel_sample(channel, time, NULL, sampled, 3);
+				for (int c = 0; c < 3; ++c)
+				{
+					if (std::abs(sampled[c] - expected[c]) > 1e-5f * std::max(1.f, std::abs(expected[c])))
+					{
+						printf("Sampled key %d of channel %d in animation %d differs from its keyframe\n", (int)key, (int)i, (int)animation_index);
+						return -1;
+					}
+				}
+			}
+		}
+	}
+
 	const cgltf_accessor* blobs = data->accessors;
 	cgltf_float element[16];
 	for (cgltf_size blob_index = 0; blob_index < data->accessors_count; ++blob_index)
 	{
 		const cgltf_accessor* blob = data->accessors + blob_index;
-		if (blob->is_sparse)
-		{
-			continue;
-		}
 		if (blob->has_max && blob->has_min)
 		{
 			cgltf_float min0 = std::numeric_limits<float>::max();
@@ -54,6 +329,263 @@ int main(int argc, char** argv)
 				return -1;
 			}
 		}
+
+		cgltf_size float_count = cgltf_accessor_unpack_floats(blob, NULL, 0);
+		std::vector<cgltf_float> unpacked(float_count);
+		if (cgltf_accessor_unpack_floats(blob, unpacked.data(), float_count) != float_count)
+		{
+			printf("Unable to unpack accessor %d\n", (int)blob_index);
+			return -1;
+		}
+		cgltf_size num_components = float_count / (blob->count ? blob->count : 1);
+		for (cgltf_size index = 0; index < blob->count; index++)
+		{
+			cgltf_accessor_read_float(blob, index, element, 16);
+			if (memcmp(element, &unpacked[index * num_components], num_components * sizeof(cgltf_float)) != 0)
+			{
+				printf("Unpacked element %d of accessor %d differs from cgltf_accessor_read_float\n", (int)index, (int)blob_index);
+				return -1;
+			}
+		}
+
+		cgltf_size index_count = cgltf_accessor_unpack_indices(blob, NULL, 4, 0);
+		std::vector<uint32_t> indices(index_count);
+		if (cgltf_accessor_unpack_indices(blob, indices.data(), 4, index_count) != index_count)
+		{
+			printf("Unable to unpack indices of accessor %d\n", (int)blob_index);
+			return -1;
+		}
+		for (cgltf_size index = 0; index < index_count; index++)
+		{
+			if (indices[index] != cgltf_accessor_read_index(blob, index))
+			{
+				printf("Unpacked index %d of accessor %d differs from cgltf_accessor_read_index\n", (int)index, (int)blob_index);
+				return -1;
+			}
+		}
+	}
+
+	options.densify_sparse = 1;
+	cgltf_data* dense_data = NULL;
+	result = cgltf_parse_file(&options, argv[1], &dense_data);
+
+	if (result == cgltf_result_success)
+		result = cgltf_load_buffers(&options, dense_data, argv[1]);
+
+	for (cgltf_size blob_index = 0; result == cgltf_result_success && blob_index < data->accessors_count; ++blob_index)
+	{
+		const cgltf_accessor* blob = data->accessors + blob_index;
+		const cgltf_accessor* dense_blob = dense_data->accessors + blob_index;
+		if (!blob->is_sparse || blob->count == 0)
+		{
+			continue;
+		}
+
+		cgltf_size float_count = cgltf_accessor_unpack_floats(blob, NULL, 0);
+		std::vector<cgltf_float> unpacked(float_count), dense_unpacked(float_count);
+		cgltf_accessor_unpack_floats(blob, unpacked.data(), float_count);
+		if (!dense_blob->sparse_data || cgltf_accessor_unpack_floats(dense_blob, dense_unpacked.data(), float_count) != float_count ||
+			memcmp(unpacked.data(), dense_unpacked.data(), float_count * sizeof(cgltf_float)) != 0)
+		{
+			printf("Densified sparse accessor %d differs from the sparse data\n", (int)blob_index);
+			return -1;
+		}
+	}
+
+	cgltf_free(dense_data);
+
+	// Loading through the file callbacks, with all reads issued up front and completed out of order,
+	// must give the same buffers as cgltf_load_buffers
+	test_files files;
+	files.outstanding = 0;
+
+	cgltf_options file_options = {};
+	file_options.file_read = test_file_read;
+	file_options.file_release = test_file_release;
+	file_options.file_read_async = test_file_read_async;
+	file_options.file_user_data = &files;
+
+	cgltf_data* async_data = NULL;
+	cgltf_buffer_loader* loader = NULL;
+	if (result == cgltf_result_success)
+		result = cgltf_parse_file(&file_options, argv[1], &async_data);
+
+	if (result == cgltf_result_success)
+		result = cgltf_load_buffers_async(&file_options, async_data, argv[1], &loader);
+
+	if (result == cgltf_result_success)
+	{
+		if (cgltf_buffer_loader_pending(loader) != files.requests.size())
+		{
+			printf("cgltf_load_buffers_async did not issue all reads up front\n");
+			return -1;
+		}
+
+		for (size_t i = files.requests.size(); i > 0; --i)
+		{
+			cgltf_size size = files.sizes[i - 1];
+			void* file_data = NULL;
+			cgltf_result read_result = test_file_read(&files, files.paths[i - 1].c_str(), &size, &file_data);
+			cgltf_buffer_loader_complete(files.requests[i - 1].first, files.requests[i - 1].second, read_result, file_data, size);
+		}
+
+		if (cgltf_buffer_loader_pending(loader) != 0)
+		{
+			printf("cgltf_buffer_loader_pending does not count completed reads\n");
+			return -1;
+		}
+
+		result = cgltf_buffer_loader_finish(loader);
+	}
+
+	for (cgltf_size i = 0; result == cgltf_result_success && i < data->buffers_count; ++i)
+	{
+		if (memcmp(data->buffers[i].data, async_data->buffers[i].data, data->buffers[i].size) != 0)
+		{
+			printf("Buffer %d loaded asynchronously differs from cgltf_load_buffers\n", (int)i);
+			return -1;
+		}
+	}
+
+	cgltf_free(async_data);
+
+	for (cgltf_size i = 0; result == cgltf_result_success && i < data->buffers_count; ++i)
+	{
+		const char* uri = data->buffers[i].uri;
+		if (uri && strncmp(uri, "data:", 5) == 0 && decode_data_uri(uri).size() >= data->buffers[i].size &&
+			memcmp(decode_data_uri(uri).data(), data->buffers[i].data, data->buffers[i].size) != 0)
+		{
+			printf("Buffer %d differs from its base64 data URI\n", (int)i);
+			return -1;
+		}
+	}
+
+	cgltf_options image_options = {};
+	image_options.decode_images = 1;
+
+	cgltf_data* image_data = NULL;
+	if (result == cgltf_result_success)
+		result = cgltf_parse_file(&image_options, argv[1], &image_data);
+
+	if (result == cgltf_result_success)
+		result = cgltf_load_buffers(&image_options, image_data, argv[1]);
+
+	for (cgltf_size i = 0; result == cgltf_result_success && i < image_data->images_count; ++i)
+	{
+		const cgltf_image* image = &image_data->images[i];
+		if (!image->uri || strncmp(image->uri, "data:", 5) != 0)
+			continue;
+
+		std::vector<unsigned char> expected = decode_data_uri(image->uri);
+		if (image->data_size != expected.size() || (!expected.empty() && memcmp(image->data, expected.data(), expected.size()) != 0))
+		{
+			printf("Image %d differs from its base64 data URI\n", (int)i);
+			return -1;
+		}
+	}
+
+	cgltf_free(image_data);
+
+	// Lazily loaded buffer views, read on demand either as byte ranges or from a mapping of the whole buffer,
+	// must match the fully loaded buffers
+	for (int memory_map = 0; result == cgltf_result_success && memory_map < 2; ++memory_map)
+	{
+		cgltf_options lazy_options = {};
+		lazy_options.memory_map = memory_map;
+		lazy_options.densify_sparse = memory_map;
+
+		cgltf_data* lazy_data = NULL;
+		result = cgltf_parse_file(&lazy_options, argv[1], &lazy_data);
+
+		if (result == cgltf_result_success)
+			result = cgltf_load_buffers_lazy(&lazy_options, lazy_data, argv[1]);
+
+		std::vector<cgltf_mesh*> meshes;
+		for (cgltf_size i = 0; result == cgltf_result_success && i < lazy_data->meshes_count; ++i)
+			meshes.push_back(&lazy_data->meshes[i]);
+
+		if (result == cgltf_result_success && !meshes.empty())
+			result = cgltf_prefetch_meshes(meshes.data(), meshes.size());
+
+		for (cgltf_size i = 0; result == cgltf_result_success && i < data->buffer_views_count; ++i)
+		{
+			const cgltf_buffer_view* view = &data->buffer_views[i];
+			const void* lazy_view_data = cgltf_buffer_view_data(&lazy_data->buffer_views[i]);
+			if (view->buffer->data && view->size && (!lazy_view_data || memcmp(lazy_view_data, (const uint8_t*)view->buffer->data + view->offset, view->size) != 0))
+			{
+				printf("Buffer view %d loaded on demand differs from cgltf_load_buffers\n", (int)i);
+				return -1;
+			}
+		}
+
+		// Views read as byte ranges leave their buffers unloaded, but validation must still check the indices in them
+		if (result == cgltf_result_success && cgltf_validate(lazy_data) != cgltf_validate(data))
+		{
+			printf("Validation of buffers loaded on demand differs from cgltf_load_buffers\n");
+			return -1;
+		}
+
+		for (cgltf_size i = 0; result == cgltf_result_success && i < data->accessors_count; ++i)
+		{
+			cgltf_size float_count = cgltf_accessor_unpack_floats(&data->accessors[i], NULL, 0);
+			std::vector<cgltf_float> expected(float_count), lazy(float_count);
+			if (cgltf_accessor_unpack_floats(&data->accessors[i], expected.data(), float_count) != cgltf_accessor_unpack_floats(&lazy_data->accessors[i], lazy.data(), float_count) ||
+				memcmp(expected.data(), lazy.data(), float_count * sizeof(cgltf_float)) != 0)
+			{
+				printf("Accessor %d loaded on demand differs from cgltf_load_buffers\n", (int)i);
+				return -1;
+			}
+		}
+
+		cgltf_free(lazy_data);
+	}
+
+	// Without buffer data, reading elements must fail instead of returning zeros or the values without their sparse overrides
+	cgltf_data* unloaded_data = NULL;
+	if (result == cgltf_result_success)
+		result = cgltf_parse_file(&options, argv[1], &unloaded_data);
+
+	for (cgltf_size i = 0; result == cgltf_result_success && i < unloaded_data->accessors_count; ++i)
+	{
+		const cgltf_accessor* accessor = &unloaded_data->accessors[i];
+		bool in_file = accessor->buffer_view && accessor->buffer_view->buffer->uri && strncmp(accessor->buffer_view->buffer->uri, "data:", 5) != 0;
+		bool sparse_in_file = accessor->is_sparse && accessor->sparse.indices_buffer_view->buffer->uri && strncmp(accessor->sparse.indices_buffer_view->buffer->uri, "data:", 5) != 0;
+		cgltf_float element[16];
+		if (accessor->count && (in_file || sparse_in_file) && cgltf_accessor_read_float(accessor, 0, element, 16))
+		{
+			printf("Accessor %d reads an element from a buffer that was not loaded\n", (int)i);
+			return -1;
+		}
+	}
+
+	cgltf_free(unloaded_data);
+
+	cgltf_options parallel_load_options = {};
+	parallel_load_options.parallel_buffers = 1;
+	parallel_load_options.run_tasks = run_tasks_reversed;
+
+	cgltf_data* parallel_data = NULL;
+	if (result == cgltf_result_success)
+		result = cgltf_parse_file(&parallel_load_options, argv[1], &parallel_data);
+
+	if (result == cgltf_result_success)
+		result = cgltf_load_buffers(&parallel_load_options, parallel_data, argv[1]);
+
+	for (cgltf_size i = 0; result == cgltf_result_success && i < data->buffers_count; ++i)
+	{
+		if (memcmp(data->buffers[i].data, parallel_data->buffers[i].data, data->buffers[i].size) != 0)
+		{
+			printf("Buffer %d loaded in parallel differs from cgltf_load_buffers\n", (int)i);
+			return -1;
+		}
+	}
+
+	cgltf_free(parallel_data);
+
+	if (files.outstanding != 0)
+	{
+		printf("cgltf_free did not release %d files read through cgltf_options::file_read\n", files.outstanding);
+		return -1;
 	}
 
 	cgltf_free(data);
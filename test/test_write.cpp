@@ -6,6 +6,91 @@
 #include <cmath>
 #include <cstdio>
 #include <limits>
+#include <vector>
+
+static bool floats_equal(const cgltf_float* a, const cgltf_float* b, cgltf_size count)
+{
+	return memcmp(a, b, count * sizeof(cgltf_float)) == 0;
+}
+
+// Floats are written with enough digits to parse back exactly.
+static bool check_float_round_trip(const cgltf_data* data0, const cgltf_data* data1)
+{
+	if (data0->accessors_count != data1->accessors_count || data0->nodes_count != data1->nodes_count ||
+		data0->materials_count != data1->materials_count)
+		return false;
+
+	for (cgltf_size i = 0; i < data0->accessors_count; ++i)
+	{
+		const cgltf_accessor* a0 = data0->accessors + i;
+		const cgltf_accessor* a1 = data1->accessors + i;
+		if ((a0->has_min && !floats_equal(a0->min, a1->min, 16)) || (a0->has_max && !floats_equal(a0->max, a1->max, 16)))
+			return false;
+	}
+
+	for (cgltf_size i = 0; i < data0->nodes_count; ++i)
+	{
+		const cgltf_node* n0 = data0->nodes + i;
+		const cgltf_node* n1 = data1->nodes + i;
+		if (!floats_equal(n0->translation, n1->translation, 3) || !floats_equal(n0->rotation, n1->rotation, 4) ||
+			!floats_equal(n0->scale, n1->scale, 3) || !floats_equal(n0->matrix, n1->matrix, 16))
+			return false;
+	}
+
+	for (cgltf_size i = 0; i < data0->materials_count; ++i)
+	{
+		const cgltf_material* m0 = data0->materials + i;
+		const cgltf_material* m1 = data1->materials + i;
+		if (!floats_equal(m0->pbr_metallic_roughness.base_color_factor, m1->pbr_metallic_roughness.base_color_factor, 4) ||
+			!floats_equal(&m0->pbr_metallic_roughness.metallic_factor, &m1->pbr_metallic_roughness.metallic_factor, 1) ||
+			!floats_equal(&m0->pbr_metallic_roughness.roughness_factor, &m1->pbr_metallic_roughness.roughness_factor, 1) ||
+			!floats_equal(m0->emissive_factor, m1->emissive_factor, 3) || !floats_equal(&m0->alpha_cutoff, &m1->alpha_cutoff, 1))
+			return false;
+	}
+
+	return true;
+}
+
+// Floats whose shortest form the sample models don't hit are written and parsed back exactly as well.
+static bool check_float_write_parse()
+{
+	static const uint32_t bits[] = { 0x15ae43fd, 0x3f800001, 0x00000001, 0x7f7fffff, 0x80000000, 0x00800000, 0x4b800001, 0x3dcccccd };
+	const cgltf_size count = sizeof(bits) / sizeof(bits[0]);
+
+	const char json[] = "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[{\"matrix\":[1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1]}]}";
+	cgltf_options options = {};
+	cgltf_data* data0 = NULL;
+	if (cgltf_parse(&options, json, sizeof(json) - 1, &data0) != cgltf_result_success)
+		return false;
+
+	memcpy(data0->nodes[0].matrix, bits, sizeof(bits));
+
+	std::vector<char> written(cgltf_write(&options, NULL, 0, data0));
+	cgltf_write(&options, written.data(), written.size(), data0);
+
+	cgltf_data* data1 = NULL;
+	bool result = cgltf_parse(&options, written.data(), written.size() - 1, &data1) == cgltf_result_success &&
+		data1->nodes_count == 1 && floats_equal(data0->nodes[0].matrix, data1->nodes[0].matrix, count);
+
+	cgltf_free(data1);
+	cgltf_free(data0);
+	return result;
+}
+
+static cgltf_size append_bytes(void* user, const void* data, cgltf_size size)
+{
+	std::vector<uint8_t>* out = (std::vector<uint8_t>*) user;
+	out->insert(out->end(), (const uint8_t*) data, (const uint8_t*) data + size);
+	return size;
+}
+
+static cgltf_size reject_bytes(void* user, const void* data, cgltf_size size)
+{
+	(void) user;
+	(void) data;
+	(void) size;
+	return 0;
+}
 
 int main(int argc, char** argv)
 {
@@ -15,6 +100,12 @@ int main(int argc, char** argv)
 		return -1;
 	}
 
+	if (!check_float_write_parse())
+	{
+		printf("Floats differ after writing and parsing again\n");
+		return -1;
+	}
+
 	cgltf_options options = {};
 	cgltf_data* data0 = NULL;
 	cgltf_result result = cgltf_parse_file(&options, argv[1], &data0);
@@ -30,6 +121,27 @@ int main(int argc, char** argv)
 	{
 		return result;
 	}
+
+	// The single-pass streaming writer must produce the same JSON as measuring and then filling a buffer.
+	std::vector<char> json(cgltf_write(&options, NULL, 0, data0));
+	cgltf_write(&options, json.data(), json.size(), data0);
+	std::vector<uint8_t> streamed;
+	result = cgltf_write_stream(&options, append_bytes, &streamed, data0);
+	if (result != cgltf_result_success)
+	{
+		return result;
+	}
+	if (streamed.size() != json.size() - 1 || memcmp(streamed.data(), json.data(), streamed.size()) != 0)
+	{
+		printf("cgltf_write_stream differs from cgltf_write\n");
+		return -1;
+	}
+	if (cgltf_write_stream(&options, reject_bytes, NULL, data0) != cgltf_result_io_error)
+	{
+		printf("cgltf_write_stream does not report a failing sink\n");
+		return -1;
+	}
+
 	cgltf_data* data1 = NULL;
 	result = cgltf_parse_file(&options, "out.gltf", &data1);
 	if (result != cgltf_result_success)
@@ -39,7 +151,54 @@ int main(int argc, char** argv)
 	if (data0->meshes_count != data1->meshes_count) {
 		return -1;
 	}
+	if (!check_float_round_trip(data0, data1))
+	{
+		printf("Floats differ after writing and parsing again\n");
+		return -1;
+	}
 	cgltf_free(data1);
+
+	// GLB output needs the buffer data, so it is only checked for files whose buffers can be loaded.
+	if (cgltf_load_buffers(&options, data0, argv[1]) == cgltf_result_success)
+	{
+		std::vector<uint8_t> glb;
+		result = cgltf_write_glb(&options, append_bytes, &glb, data0);
+		if (result != cgltf_result_success)
+		{
+			return result;
+		}
+		if (glb.size() % 4 != 0)
+		{
+			printf("GLB output is not padded to 4 bytes\n");
+			return -1;
+		}
+		cgltf_data* data2 = NULL;
+		result = cgltf_parse(&options, glb.data(), glb.size(), &data2);
+		if (result == cgltf_result_success)
+			result = cgltf_load_buffers(&options, data2, argv[1]);
+		if (result != cgltf_result_success)
+		{
+			return result;
+		}
+		if (data2->file_type != cgltf_file_type_glb || data0->meshes_count != data2->meshes_count ||
+			data0->buffers_count != data2->buffers_count ||
+			(data0->buffers_count > 0 && (data0->buffers[0].size != data2->buffers[0].size ||
+			memcmp(data0->buffers[0].data, data2->buffers[0].data, data0->buffers[0].size) != 0)))
+		{
+			printf("GLB output differs from the input\n");
+			return -1;
+		}
+		cgltf_free(data2);
+
+		result = cgltf_write_glb_file(&options, "out.glb", data0);
+		if (result == cgltf_result_success)
+			result = cgltf_parse_file(&options, "out.glb", &data2);
+		if (result != cgltf_result_success)
+		{
+			return result;
+		}
+		cgltf_free(data2);
+	}
 	cgltf_free(data0);
 	return cgltf_result_success;
 }